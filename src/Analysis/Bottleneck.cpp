@@ -0,0 +1,178 @@
+#include "Bottleneck.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+// =======================================================
+// Funkcje pomocnicze
+// =======================================================
+
+// Nadawca paczek do robotnika (krawędź odwrotna)
+struct Inbound {
+    bool from_ramp;
+    std::size_t from;   // indeks robotnika (gdy nie rampa)
+    double flow;        // szacowana liczba paczek przekazanych
+    ElementID id;
+};
+
+static WorkerUsage usage_of(const Worker& w, Time turns) {
+    const WorkerStats& st = w.get_stats();
+
+    WorkerUsage u;
+    u.id = w.get_id();
+    u.processed = st.processed;
+    u.busy = st.busy_turns;
+    if (w.is_processing()) {
+        // skończona paczka czekająca na wolny bufor -> blokada, nie praca
+        const long long duration = std::max<long long>(w.get_processing_duration(), 1);
+        u.busy += std::min<long long>(turns - w.get_package_processing_start_time() + 1, duration);
+    }
+    // partie w obróbce: ceil(n / B) stanowisk od startu grupy
+    const auto& in_flight = w.get_in_flight();
+    const std::size_t batch = w.get_batch_size();
+    for (auto it = in_flight.begin(); it != in_flight.end();) {
+        auto group = std::find_if(it, in_flight.end(),
+            [start = it->start](const InFlightPackage& p) { return p.start != start; });
+        const auto n = static_cast<std::size_t>(group - it);
+        u.busy += static_cast<long long>((n + batch - 1) / batch) * (turns - it->start + 1);
+        it = group;
+    }
+
+    // k stanowisk -> k tur obróbki na turę symulacji
+    const long long capacity = static_cast<long long>(turns) * w.get_servers();
+    u.blocked = w.get_blocked_turns();
+    u.rejected = st.rejected;
+    u.idle = std::max(0LL, capacity - u.busy - u.blocked);
+    u.utilization = (capacity > 0) ? static_cast<double>(u.busy + u.blocked) / capacity : 0.0;
+
+    // paczki obecne do końca przebiegu liczone do tury turns włącznie
+    long long resident = static_cast<long long>(st.received - st.processed);
+    u.residence = st.departure_time_sum + resident * (turns + 1)
+        - st.arrival_time_sum + u.blocked;
+    u.mean_sojourn = (st.received > 0)
+        ? static_cast<double>(u.residence) / st.received : 0.0;
+    return u;
+}
+
+// =======================================================
+// Funkcja analyze_bottlenecks()
+// =======================================================
+
+BottleneckReport analyze_bottlenecks(const Factory& f, Time turns) {
+    BottleneckReport report;
+    report.turns = turns;
+
+    std::vector<const Worker*> workers;
+    std::unordered_map<const IPackageReceiver*, std::size_t> index;
+    std::vector<WorkerUsage> usage;
+    for (auto it = f.worker_cbegin(); it != f.worker_cend(); ++it) {
+        index.emplace(&*it, workers.size());
+        workers.push_back(&*it);
+        usage.push_back(usage_of(*it, turns));
+    }
+    if (workers.empty()) return report;
+
+    // udział w czasie realizacji
+    long long total = 0;
+    for (const auto& u : usage) total += u.residence;
+    for (auto& u : usage) {
+        u.lead_time_share = (total > 0) ? static_cast<double>(u.residence) / total : 0.0;
+    }
+
+    // wąskie gardło: największe obciążenie (pierwszy w kolejności fabryki)
+    std::size_t b = 0;
+    for (std::size_t i = 1; i < usage.size(); ++i) {
+        if (usage[i].utilization > usage[b].utilization) b = i;
+    }
+    report.bottleneck = usage[b].id;
+
+    // krawędzie odwrotne: kto wysyła do robotnika i ile
+    std::vector<std::vector<Inbound>> inbound(workers.size());
+    for (auto it = f.ramp_cbegin(); it != f.ramp_cend(); ++it) {
+        const DurationDistribution& dist = it->get_delivery_stream().get_distribution();
+        TimeOffset di = it->get_delivery_interval();
+        double deliveries = 0;
+        if (it->get_trace()) {
+            // zapis dostaw: paczki z pliku do tury turns, najwyżej jedna na turę
+            std::uint64_t arrivals = summarize_trace(it->get_trace()->get_source(), turns).arrivals;
+            deliveries = static_cast<double>(std::min<std::uint64_t>(arrivals, turns > 0 ? turns : 0));
+        } else if (dist.is_fixed()) {
+            deliveries = (di > 0 && turns > 0) ? (turns - 1) / di + 1 : 0;
+        } else if (turns > 0) {
+            // odstęp losowy: średnio turns / średni odstęp (pierwsza w turze 1)
+            deliveries = (turns - 1) / dist.mean() + 1;
+        }
+        for (const auto& pref : it->receiver_preferences) {
+            auto w = index.find(pref.first);
+            if (w == index.end()) continue;
+            inbound[w->second].push_back(
+                Inbound{true, 0, deliveries * pref.second, it->get_id()});
+        }
+    }
+    for (std::size_t v = 0; v < workers.size(); ++v) {
+        for (const auto& pref : workers[v]->receiver_preferences) {
+            auto w = index.find(pref.first);
+            if (w == index.end()) continue;
+            inbound[w->second].push_back(
+                Inbound{false, v, usage[v].processed * pref.second, workers[v]->get_id()});
+        }
+    }
+
+    // w górę: nadawca o największym przepływie, aż do rampy
+    std::vector<char> visited(workers.size(), 0);
+    std::vector<ChainNode> upstream;
+    visited[b] = 1;
+    for (std::size_t cur = b;;) {
+        const Inbound* best = nullptr;
+        for (const Inbound& e : inbound[cur]) {
+            if (!e.from_ramp && visited[e.from]) continue;
+            if (!best || e.flow > best->flow) best = &e;
+        }
+        if (!best) break;
+
+        if (best->from_ramp) {
+            upstream.push_back(ChainNode{ChainNodeType::RAMP, best->id});
+            break;
+        }
+        cur = best->from;
+        visited[cur] = 1;
+        upstream.push_back(ChainNode{ChainNodeType::WORKER, best->id});
+    }
+    report.limiting_chain.assign(upstream.rbegin(), upstream.rend());
+    report.limiting_chain.push_back(ChainNode{ChainNodeType::WORKER, usage[b].id});
+
+    // w dół: najbardziej obciążony następnik, aż do magazynu
+    for (std::size_t cur = b;;) {
+        const IPackageReceiver* store = nullptr;
+        std::size_t next = workers.size();
+        for (const auto& pref : workers[cur]->receiver_preferences) {
+            auto w = index.find(pref.first);
+            if (w == index.end()) {
+                if (!store) store = pref.first;
+            } else if (!visited[w->second] &&
+                       (next == workers.size() ||
+                        usage[w->second].utilization > usage[next].utilization)) {
+                next = w->second;
+            }
+        }
+
+        if (next != workers.size()) {
+            visited[next] = 1;
+            report.limiting_chain.push_back(ChainNode{ChainNodeType::WORKER, usage[next].id});
+            cur = next;
+        } else {
+            if (store) {
+                report.limiting_chain.push_back(ChainNode{ChainNodeType::STOREHOUSE, store->get_id()});
+            }
+            break;
+        }
+    }
+
+    // ranking wg udziału w czasie realizacji
+    report.ranking = usage;
+    std::stable_sort(report.ranking.begin(), report.ranking.end(),
+        [](const WorkerUsage& a, const WorkerUsage& b) {
+            return a.lead_time_share > b.lead_time_share;
+        });
+    return report;
+}
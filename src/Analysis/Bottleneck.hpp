@@ -0,0 +1,64 @@
+#pragma once
+
+// ==============================
+// Bottleneck.hpp
+// ==============================
+// Analiza wąskich gardeł po przebiegu symulacji
+//
+// Odpowiada za:
+// - podział tur robotnika na pracę / blokadę / bezczynność
+//   (liczniki z Worker::finish_processing i PackageSender::send_package)
+// - udział robotnika w czasie realizacji (lead time): suma czasu pobytu
+//   paczek u robotnika (prawo Little'a) względem sumy po wszystkich
+// - ranking robotników według tego udziału
+// - łańcuch ograniczający przepustowość: od najbardziej obciążonego
+//   robotnika w górę (nadawca o największym przepływie) do rampy
+//   i w dół (najbardziej obciążony następnik) do magazynu
+//
+// Czasy przybycia wymagają zegara fabryki (Worker::attach_clock),
+// więc analiza dotyczy robotników symulowanych przez Factory.
+// ==============================
+
+#include <cstddef>
+#include <vector>
+
+#include "Factory/factory.hpp"
+
+// =======================================================
+// Wynik analizy
+// =======================================================
+
+struct WorkerUsage {
+    ElementID id;
+    long long busy = 0;            // tury obróbki (suma po stanowiskach)
+    long long blocked = 0;         // tury z paczką w buforze bez odbiorcy
+    long long idle = 0;            // pozostałe tury (turns * servers - busy - blocked)
+    double utilization = 0.0;      // (busy + blocked) / (turns * servers)
+    std::size_t processed = 0;     // zakończone obróbki
+    std::size_t rejected = 0;      // odmowy przyjęcia (pełna kolejka)
+    long long residence = 0;       // suma tur pobytu paczek (kolejka + obróbka + blokada)
+    double mean_sojourn = 0.0;     // residence / przyjęte paczki
+    double lead_time_share = 0.0;  // residence / suma residence robotników
+};
+
+enum class ChainNodeType { RAMP, WORKER, STOREHOUSE };
+
+struct ChainNode {
+    ChainNodeType type;
+    ElementID id;
+};
+
+struct BottleneckReport {
+    Time turns = 0;
+    std::vector<WorkerUsage> ranking;       // malejąco wg lead_time_share
+    ElementID bottleneck = 0;               // największe utilization (0 -> brak robotników)
+    std::vector<ChainNode> limiting_chain;  // rampa -> ... -> magazyn
+};
+
+// =======================================================
+// Funkcja analyze_bottlenecks()
+// =======================================================
+//
+// turns -> liczba zasymulowanych tur (ostatnia tura przebiegu)
+//
+BottleneckReport analyze_bottlenecks(const Factory& f, Time turns);
@@ -0,0 +1,175 @@
+#include "Queueing.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+// =======================================================
+// Graf przepływu
+// =======================================================
+
+struct Inflow {
+    std::size_t from;   // indeks robotnika nadawcy
+    double p;           // prawdopodobieństwo przejścia
+};
+
+// Czas losowy -> średnia rozkładu
+static double rate_of(const DurationStream& stream) {
+    double interval = stream.get_distribution().mean();
+    return (interval > 0) ? 1.0 / interval : INFINITY;
+}
+
+// Średnia liczba dostaw na turę rampy; zapis dostaw -> jeden przebieg
+// pliku (rampa wydaje najwyżej jedną paczkę na turę)
+static double arrival_rate(const Ramp& ramp) {
+    if (!ramp.get_trace()) {
+        return rate_of(ramp.get_delivery_stream());
+    }
+    TraceSummary summary = summarize_trace(ramp.get_trace()->get_source(),
+                                           std::numeric_limits<Time>::max());
+    if (summary.last_turn <= 0) return 0.0;
+    return std::min(static_cast<double>(summary.arrivals) / summary.last_turn, 1.0);
+}
+
+// Porządek topologiczny robotników (Kahn); węzły cykli dopisane na końcu
+static std::vector<std::size_t> topological_order(
+    const std::vector<std::vector<Inflow>>& inflows
+) {
+    const std::size_t n = inflows.size();
+    std::vector<std::vector<std::size_t>> out(n);
+    std::vector<std::size_t> indegree(n, 0);
+    for (std::size_t w = 0; w < n; ++w) {
+        for (const Inflow& e : inflows[w]) {
+            out[e.from].push_back(w);
+            ++indegree[w];
+        }
+    }
+
+    std::vector<std::size_t> order;
+    std::vector<char> placed(n, 0);
+    for (std::size_t w = 0; w < n; ++w) {
+        if (indegree[w] == 0) order.push_back(w);
+    }
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        placed[order[i]] = 1;
+        for (std::size_t w : out[order[i]]) {
+            if (--indegree[w] == 0) order.push_back(w);
+        }
+    }
+    for (std::size_t w = 0; w < n; ++w) {
+        if (!placed[w] && indegree[w] != 0) order.push_back(w);
+    }
+    return order;
+}
+
+// =======================================================
+// Funkcja analyze_queueing()
+// =======================================================
+
+QueueingEstimate analyze_queueing(
+    const Factory& f,
+    double tolerance,
+    std::size_t max_iterations
+) {
+    QueueingEstimate est;
+
+    std::unordered_map<const IPackageReceiver*, std::size_t> worker_index, store_index;
+    for (auto it = f.worker_cbegin(); it != f.worker_cend(); ++it) {
+        worker_index.emplace(&*it, est.workers.size());
+        WorkerLoad load;
+        load.id = it->get_id();
+        load.service_rate = rate_of(it->get_processing_stream());
+        if (it->is_multi_server()) {
+            // k stanowisk po B paczek; wyjście najwyżej jedna paczka na turę
+            double capacity = static_cast<double>(it->get_servers() * it->get_batch_size());
+            load.service_rate = std::min(capacity * load.service_rate, 1.0);
+        }
+        // przekierowania i blokady przy pełnej kolejce poza równaniami
+        est.bounded_queues = est.bounded_queues || it->get_queue_capacity() > 0;
+        est.workers.push_back(load);
+    }
+    for (auto it = f.storehouse_cbegin(); it != f.storehouse_cend(); ++it) {
+        store_index.emplace(&*it, est.storehouses.size());
+        StorehouseLoad load;
+        load.id = it->get_id();
+        est.storehouses.push_back(load);
+    }
+
+    const std::size_t n = est.workers.size();
+    std::vector<double> external(n, 0.0);               // napływ z ramp
+    std::vector<std::vector<Inflow>> inflows(n);        // robotnik -> robotnik
+    std::vector<std::vector<Inflow>> store_inflows(est.storehouses.size());
+
+    // Rampy: napływ zewnętrzny (do robotników i wprost do magazynów)
+    std::vector<double> store_external(est.storehouses.size(), 0.0);
+    for (auto it = f.ramp_cbegin(); it != f.ramp_cend(); ++it) {
+        double rate = arrival_rate(*it);
+        est.offered_rate += rate;
+        for (const auto& pref : it->receiver_preferences) {
+            auto w = worker_index.find(pref.first);
+            if (w != worker_index.end()) {
+                external[w->second] += rate * pref.second;
+            } else {
+                store_external[store_index.at(pref.first)] += rate * pref.second;
+            }
+        }
+    }
+
+    // Robotnicy: przejścia do kolejnych węzłów
+    std::size_t v = 0;
+    for (auto it = f.worker_cbegin(); it != f.worker_cend(); ++it, ++v) {
+        for (const auto& pref : it->receiver_preferences) {
+            auto w = worker_index.find(pref.first);
+            if (w != worker_index.end()) {
+                inflows[w->second].push_back(Inflow{v, pref.second});
+            } else {
+                store_inflows[store_index.at(pref.first)].push_back(Inflow{v, pref.second});
+            }
+        }
+    }
+
+    // Równania przepływu (Gauss-Seidel w porządku topologicznym)
+    std::vector<std::size_t> order = topological_order(inflows);
+    std::vector<double> lambda(n, 0.0);
+    auto output = [&](std::size_t w) {
+        return std::min(lambda[w], est.workers[w].service_rate);
+    };
+
+    est.converged = false;
+    while (est.iterations < max_iterations) {
+        ++est.iterations;
+        double change = 0.0;
+        for (std::size_t w : order) {
+            double l = external[w];
+            for (const Inflow& e : inflows[w]) {
+                l += output(e.from) * e.p;
+            }
+            change = std::max(change, std::fabs(l - lambda[w]) / std::max(1.0, l));
+            lambda[w] = l;
+        }
+        if (change <= tolerance) {
+            est.converged = true;
+            break;
+        }
+    }
+
+    for (std::size_t w = 0; w < n; ++w) {
+        WorkerLoad& load = est.workers[w];
+        load.arrival_rate = lambda[w];
+        load.utilization = lambda[w] / load.service_rate;
+        load.throughput = output(w);
+        load.saturated = load.utilization >= 1.0;
+    }
+
+    for (std::size_t s = 0; s < est.storehouses.size(); ++s) {
+        double l = store_external[s];
+        for (const Inflow& e : store_inflows[s]) {
+            l += output(e.from) * e.p;
+        }
+        est.storehouses[s].arrival_rate = l;
+        est.throughput += l;
+    }
+
+    return est;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+// ==============================
+// Queueing.hpp
+// ==============================
+// Analityczne oszacowanie obciążenia sieci (bez symulacji)
+//
+// Odpowiada za:
+// - intensywność napływu z ramp: 1 / delivery-interval
+// - intensywność obsługi robotnika: 1 / processing-time
+//   (k stanowisk, partie B: min(k * B / processing-time, 1))
+//   (czasy losowe -> średnia rozkładu)
+// - prawdopodobieństwa przejść z ReceiverPreferences
+// - rozwiązanie równań przepływu:
+//     lambda_w = sum_r rate_r * p_rw + sum_v min(lambda_v, mu_v) * p_vw
+//   (robotnik przeciążony oddaje najwyżej mu paczek na turę)
+// - oznaczenie robotników z obciążeniem rho = lambda / mu >= 1
+//   (kolejka rośnie bez ograniczeń)
+//
+// Robotnicy przetwarzani są w porządku topologicznym, więc sieć bez cykli
+// rozwiązuje jedno przejście; cykle rozwiązuje iteracja Gaussa-Seidla.
+//
+// Kolejki z limitem (queue-capacity) nie są modelowane: równania nie
+// uwzględniają przekierowań do kolejnych odbiorców przy pełnej kolejce
+// ani blokad nadawców. Wynik ma wtedy ustawione bounded_queues
+// (oszacowanie przybliżone).
+// ==============================
+
+#include <cstddef>
+#include <vector>
+
+#include "Factory/factory.hpp"
+
+// =======================================================
+// Wynik analizy
+// =======================================================
+
+struct WorkerLoad {
+    ElementID id;
+    double arrival_rate = 0.0;   // lambda (paczki na turę)
+    double service_rate = 0.0;   // mu
+    double utilization = 0.0;    // rho = lambda / mu
+    double throughput = 0.0;     // min(lambda, mu)
+    bool saturated = false;      // rho >= 1
+};
+
+struct StorehouseLoad {
+    ElementID id;
+    double arrival_rate = 0.0;
+};
+
+struct QueueingEstimate {
+    std::vector<WorkerLoad> workers;          // w kolejności fabryki
+    std::vector<StorehouseLoad> storehouses;
+    double offered_rate = 0.0;   // suma napływu z ramp
+    double throughput = 0.0;     // suma napływu do magazynów
+    std::size_t iterations = 0;  // przejścia Gaussa-Seidla
+    bool converged = true;
+    bool bounded_queues = false; // limity kolejek pominięte (przybliżenie)
+};
+
+// =======================================================
+// Funkcja analyze_queueing()
+// =======================================================
+//
+// tolerance      -> maksymalna zmiana lambda w ostatnim przejściu
+// max_iterations -> limit przejść (cykle o wolnej zbieżności)
+//
+QueueingEstimate analyze_queueing(
+    const Factory& f,
+    double tolerance = 1e-12,
+    std::size_t max_iterations = 10000
+);
@@ -0,0 +1,146 @@
+#include "Affinity.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// =======================================================
+// Topologia
+// =======================================================
+
+// Format cpulist z sysfs: "0-3,8,10-11"
+static std::vector<int> parse_cpulist(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream ss(text);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        if (range.empty() || range == "\n") continue;
+        std::size_t dash = range.find('-');
+        int first = std::stoi(range.substr(0, dash));
+        int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+        for (int c = first; c <= last; ++c) {
+            cpus.push_back(c);
+        }
+    }
+    return cpus;
+}
+
+NumaTopology detect_numa_topology() {
+    namespace fs = std::filesystem;
+
+    NumaTopology topology;
+    std::vector<std::pair<int, std::vector<int>>> found;
+
+    std::error_code ec;
+    fs::directory_iterator it("/sys/devices/system/node", ec);
+    if (!ec) {
+        for (const fs::directory_entry& entry : it) {
+            const std::string name = entry.path().filename().string();
+            if (name.size() <= 4 || name.compare(0, 4, "node") != 0 ||
+                !std::all_of(name.begin() + 4, name.end(), ::isdigit)) {
+                continue;
+            }
+
+            std::ifstream is(entry.path() / "cpulist");
+            std::string text;
+            if (!is || !std::getline(is, text)) continue;
+
+            std::vector<int> cpus = parse_cpulist(text);
+            if (!cpus.empty()) {
+                found.emplace_back(std::stoi(name.substr(4)), std::move(cpus));
+            }
+        }
+    }
+
+    std::sort(found.begin(), found.end());
+    for (auto& node : found) {
+        topology.nodes.push_back(std::move(node.second));
+    }
+
+    // brak sysfs -> jeden węzeł ze wszystkimi procesorami procesu
+    if (topology.nodes.empty()) {
+        topology.nodes.push_back(current_thread_cpus());
+    }
+    return topology;
+}
+
+std::vector<ThreadPlacement> place_threads(const NumaTopology& topology, unsigned threads) {
+    std::vector<ThreadPlacement> placement;
+    const std::size_t nodes = topology.nodes.size();
+    std::vector<std::size_t> used(nodes, 0);
+
+    for (unsigned k = 0; k < threads; ++k) {
+        const std::size_t node = static_cast<std::size_t>(k) * nodes / threads;
+        const std::vector<int>& cpus = topology.nodes[node];
+        placement.push_back(ThreadPlacement{node, cpus[used[node]++ % cpus.size()]});
+    }
+    return placement;
+}
+
+// =======================================================
+// Przypięcie wątku
+// =======================================================
+
+bool pin_current_thread(const std::vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c : cpus) {
+        if (c >= 0 && c < CPU_SETSIZE) CPU_SET(c, &set);
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+std::vector<int> current_thread_cpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+        for (int c = 0; c < CPU_SETSIZE; ++c) {
+            if (CPU_ISSET(c, &set)) cpus.push_back(c);
+        }
+    }
+    return cpus;
+}
+
+// =======================================================
+// NodeLocalArena
+// =======================================================
+
+// Przydział i pierwszy zapis bufora w wątku przypiętym do węzła
+static std::unique_ptr<unsigned char[]> first_touch(std::size_t size, const std::vector<int>& cpus) {
+    std::unique_ptr<unsigned char[]> buffer;
+    std::exception_ptr error;
+    std::thread toucher([&] {
+        try {
+            pin_current_thread(cpus);
+            buffer.reset(new unsigned char[size]);
+            std::memset(buffer.get(), 0, size);
+        } catch (...) {
+            error = std::current_exception();
+        }
+    });
+    toucher.join();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return buffer;
+}
+
+NodeLocalArena::NodeLocalArena(std::size_t size, const std::vector<int>& cpus)
+    : buffer_(first_touch(size, cpus)),
+      monotonic_(buffer_.get(), size, std::pmr::new_delete_resource()),
+      pool_(&monotonic_) {}
+
+std::pmr::memory_resource* NodeLocalArena::resource() {
+    return &pool_;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+// ==============================
+// Affinity.hpp
+// ==============================
+// Topologia NUMA i przypięcie wątków do rdzeni
+//
+// Odpowiada za:
+// - odczyt węzłów NUMA i ich procesorów (/sys/devices/system/node)
+// - rozmieszczenie wątków puli: kolejne bloki wątków na kolejnych
+//   węzłach, w węźle kolejne rdzenie
+// - przypięcie bieżącego wątku do zbioru procesorów (i odczyt zbioru)
+// - arenę pamięci węzła: bufor zapisany w całości (first touch) przez
+//   wątek przypięty do węzła, więc jego strony leżą w pamięci tego węzła
+//
+// Tylko Linux; bez sysfs topologia ma jeden węzeł (wtedy wszystko jest no-op).
+// ==============================
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// =======================================================
+// Topologia
+// =======================================================
+
+struct NumaTopology {
+    // procesory węzła; węzły bez procesorów są pomijane
+    std::vector<std::vector<int>> nodes;
+
+    bool is_numa() const { return nodes.size() > 1; }
+};
+
+NumaTopology detect_numa_topology();
+
+struct ThreadPlacement {
+    std::size_t node;   // indeks w NumaTopology::nodes
+    int cpu;
+};
+
+// Wątek k -> węzeł k * nodes / threads, rdzenie węzła po kolei (cyklicznie)
+std::vector<ThreadPlacement> place_threads(const NumaTopology& topology, unsigned threads);
+
+// =======================================================
+// Przypięcie wątku
+// =======================================================
+
+// false -> system odrzucił zbiór (np. procesor poza cpuset procesu)
+bool pin_current_thread(const std::vector<int>& cpus);
+std::vector<int> current_thread_cpus();
+
+// =======================================================
+// NodeLocalArena
+// =======================================================
+//
+// Jak SimulationArena, ale bufor początkowy jest przydzielony i zapisany
+// przez pomocniczy wątek przypięty do procesorów węzła. Pool jest
+// synchronizowany (kolejki części używa kilka wątków puli).
+// Po wyczerpaniu bufora kolejne bloki pochodzą z new/delete.
+//
+class NodeLocalArena {
+public:
+    NodeLocalArena(std::size_t size, const std::vector<int>& cpus);
+
+    NodeLocalArena(const NodeLocalArena&) = delete;
+    NodeLocalArena& operator=(const NodeLocalArena&) = delete;
+
+    std::pmr::memory_resource* resource();
+
+private:
+    std::unique_ptr<unsigned char[]> buffer_;
+    std::pmr::monotonic_buffer_resource monotonic_;
+    std::pmr::synchronized_pool_resource pool_;
+};
@@ -0,0 +1,28 @@
+#include "Inbox.hpp"
+
+#include <algorithm>
+
+bool PackageInbox::push(InboxEntry* entry) {
+    InboxEntry* head = head_.load(std::memory_order_relaxed);
+    do {
+        entry->next = head;
+    } while (!head_.compare_exchange_weak(head, entry,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+    return head == nullptr;
+}
+
+void PackageInbox::drain(std::vector<InboxEntry*>& out) {
+    out.clear();
+    for (InboxEntry* e = head_.exchange(nullptr, std::memory_order_acquire); e; e = e->next) {
+        out.push_back(e);
+    }
+
+    // stos -> kolejność zapisów zależy od wątków; porządek nadawców jest stały
+    std::sort(out.begin(), out.end(),
+        [](const InboxEntry* a, const InboxEntry* b) { return a->sender < b->sender; });
+}
+
+bool PackageInbox::empty() const {
+    return head_.load(std::memory_order_acquire) == nullptr;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+// ==============================
+// Inbox.hpp
+// ==============================
+// Skrzynka odbiorcza paczek bez blokad (wielu nadawców, jeden odbiorca)
+//
+// Odpowiada za:
+// - równoległe przekazywanie paczek: nadawcy wielu wątków dopisują wpisy
+//   do skrzynki odbiorcy jedną operacją CAS (stos Treibera, bez mutexa)
+// - deterministyczne opróżnienie na granicy fazy: wpisy rosnąco wg
+//   indeksu nadawcy (rampy, potem robotnicy), czyli w tej samej kolejności,
+//   w jakiej odbiorca dostaje paczki w Factory::do_package_passing()
+//
+// Wpisy nie są alokowane w fazie: każdy nadawca ma jeden wpis
+// (wysyła najwyżej jedną paczkę na turę).
+// ==============================
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "Package/Package.hpp"
+
+// =======================================================
+// Wpis skrzynki
+// =======================================================
+
+struct InboxEntry {
+    std::uint32_t sender = 0;          // indeks nadawcy w FactorySnapshot
+    std::optional<Package> package;
+    InboxEntry* next = nullptr;
+};
+
+// =======================================================
+// PackageInbox
+// =======================================================
+
+class PackageInbox {
+public:
+    // Dopisuje wpis (dowolny wątek); true -> skrzynka była pusta
+    bool push(InboxEntry* entry);
+
+    // Zabiera wszystkie wpisy do out, rosnąco wg nadawcy
+    // (jeden wątek, po zakończeniu zapisów fazy)
+    void drain(std::vector<InboxEntry*>& out);
+
+    bool empty() const;
+
+private:
+    std::atomic<InboxEntry*> head_{nullptr};
+};
@@ -0,0 +1,110 @@
+#include "Snapshot.hpp"
+
+#include <stdexcept>
+#include <unordered_map>
+
+// =======================================================
+// Kompilacja obrazu
+// =======================================================
+
+FactorySnapshot::FactorySnapshot(std::vector<Ramp*> ramps,
+                                 std::vector<Worker*> workers,
+                                 std::vector<Storehouse*> storehouses,
+                                 std::uint64_t generation)
+    : generation_(generation),
+      ramps_(std::move(ramps)),
+      workers_(std::move(workers)),
+      storehouses_(std::move(storehouses)) {
+    std::unordered_map<const IPackageReceiver*, ReceiverHandle> handles;
+    for (std::size_t i = 0; i < workers_.size(); ++i) {
+        handles[workers_[i]] = {ReceiverType::WORKER, static_cast<std::uint32_t>(i)};
+    }
+    for (std::size_t i = 0; i < storehouses_.size(); ++i) {
+        handles[storehouses_[i]] = {ReceiverType::STOREHOUSE, static_cast<std::uint32_t>(i)};
+    }
+
+    senders_.reserve(ramps_.size() + workers_.size());
+    delivery_intervals_.reserve(ramps_.size());
+    for (Ramp* r : ramps_) {
+        senders_.push_back(r);
+        delivery_intervals_.push_back(r->get_delivery_interval());
+    }
+    for (Worker* w : workers_) {
+        senders_.push_back(w);
+        bounded_ = bounded_ || w->get_queue_capacity() > 0;
+    }
+
+    // kolejność wag = kolejność mapy preferencji (jak w choose_receiver)
+    offsets_.reserve(senders_.size() + 1);
+    offsets_.push_back(0);
+    for (PackageSender* sender : senders_) {
+        for (const auto& kv : sender->receiver_preferences) {
+            auto h = handles.find(kv.first);
+            if (h == handles.end()) {
+                throw std::logic_error("Receiver outside of the factory");
+            }
+            successors_.push_back(h->second);
+            weights_.push_back(kv.second);
+        }
+        offsets_.push_back(static_cast<std::uint32_t>(successors_.size()));
+    }
+}
+
+// =======================================================
+// Przekazywanie paczek
+// =======================================================
+
+std::uint32_t FactorySnapshot::choose(std::size_t i) const {
+    PackageSender* sender = senders_[i];
+    const std::uint32_t first = offsets_[i];
+    const std::uint32_t last = offsets_[i + 1];
+
+    if (first != last && sender->receiver_preferences.get_probability_generator()) {
+        double p = sender->receiver_preferences.draw();
+        double sum = 0.0;
+
+        for (std::uint32_t k = first; k < last; ++k) {
+            sum += weights_[k];
+            if (p <= sum) {
+                if (!bounded_) return k;
+
+                // pełna kolejka -> kolejni odbiorcy (cyklicznie)
+                for (std::uint32_t n = 0; n < last - first; ++n) {
+                    std::uint32_t slot = first + (k - first + n) % (last - first);
+                    const ReceiverHandle h = successors_[slot];
+                    if (h.type != ReceiverType::WORKER || workers_[h.index]->can_receive()) {
+                        return slot;
+                    }
+                    workers_[h.index]->record_rejection();
+                }
+                break;
+            }
+        }
+    }
+
+    // nie wylosowano odbiorcy (lub wszyscy mają pełne kolejki)
+    // -> paczka zostaje w buforze
+    sender->record_blocked_turn();
+    return NO_RECEIVER;
+}
+
+void FactorySnapshot::send(std::size_t i) const {
+    PackageSender* sender = senders_[i];
+    if (!sender->has_package()) return;
+
+    std::uint32_t k = choose(i);
+    if (k != NO_RECEIVER) {
+        dispatch(successors_[k], sender->take_package());
+    }
+}
+
+void FactorySnapshot::dispatch(ReceiverHandle h, Package&& p) const {
+    switch (h.type) {
+        case ReceiverType::WORKER:
+            workers_[h.index]->receive_package(std::move(p));
+            break;
+        case ReceiverType::STOREHOUSE:
+            storehouses_[h.index]->receive_package(std::move(p));
+            break;
+    }
+}
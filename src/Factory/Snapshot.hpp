@@ -0,0 +1,102 @@
+#pragma once
+
+// ==============================
+// Snapshot.hpp
+// ==============================
+// Skompilowany, niezmienny obraz topologii fabryki
+//
+// Odpowiada za:
+// - gęste indeksy węzłów: rampy, robotnicy, magazyny w tablicach
+//   (nadawcy: najpierw rampy, potem robotnicy -> indeks nadawcy)
+// - stałe węzłów w ciągłych tablicach (interwały dostaw)
+// - graf następników w formacie CSR: offsets[i] .. offsets[i + 1]
+//   to zakres odbiorców i wag nadawcy i w successors / weights
+// - przekazanie paczki nadawcy: losowanie, przeszukanie wag
+//   (ta sama kolejność i arytmetyka co ReceiverPreferences::choose_receiver)
+//   i dostarczenie przez switch po rodzaju odbiorcy
+//
+// Factory trzyma węzły do edycji i kompiluje obraz ponownie po zmianie
+// topologii (Factory::snapshot()). Obraz nie jest modyfikowany po
+// zbudowaniu; zmieniają się tylko stany węzłów, na które wskazuje.
+// ==============================
+
+#include <cstdint>
+#include <vector>
+
+#include "Nodes/Nodes.hpp"
+
+// =======================================================
+// Uchwyt odbiorcy
+// =======================================================
+
+struct ReceiverHandle {
+    ReceiverType type;     // WORKER / STOREHOUSE
+    std::uint32_t index;   // pozycja w tablicy węzłów danego rodzaju
+};
+
+// =======================================================
+// FactorySnapshot
+// =======================================================
+
+class FactorySnapshot {
+public:
+    // Węzły w kolejności kolekcji fabryki; generation -> numer kompilacji
+    FactorySnapshot(std::vector<Ramp*> ramps,
+                    std::vector<Worker*> workers,
+                    std::vector<Storehouse*> storehouses,
+                    std::uint64_t generation);
+
+    FactorySnapshot(const FactorySnapshot&) = delete;
+    FactorySnapshot& operator=(const FactorySnapshot&) = delete;
+
+    std::uint64_t generation() const { return generation_; }
+
+    // --- węzły (gęste indeksy) ---
+    const std::vector<Ramp*>& ramps() const { return ramps_; }
+    const std::vector<Worker*>& workers() const { return workers_; }
+    const std::vector<Storehouse*>& storehouses() const { return storehouses_; }
+    const std::vector<PackageSender*>& senders() const { return senders_; }
+
+    // czy któryś robotnik ma ograniczoną kolejkę (wynik przekazania
+    // zależy wtedy od kolejności nadawców w turze)
+    bool has_bounded_queues() const { return bounded_; }
+
+    // --- stałe węzłów ---
+    const std::vector<TimeOffset>& delivery_intervals() const { return delivery_intervals_; }
+
+    // --- CSR ---
+    // offsets().size() == senders().size() + 1
+    const std::vector<std::uint32_t>& offsets() const { return offsets_; }
+    const std::vector<ReceiverHandle>& successors() const { return successors_; }
+    const std::vector<double>& weights() const { return weights_; }
+
+    // Brak odbiorcy w choose()
+    static constexpr std::uint32_t NO_RECEIVER = UINT32_MAX;
+
+    // Losuje odbiorcę nadawcy i: pozycja w successors() lub NO_RECEIVER
+    // (wtedy liczona jest tura blokady nadawcy). Paczka zostaje w buforze.
+    // Wylosowany robotnik z pełną kolejką -> kolejni odbiorcy nadawcy
+    // (jak PackageSender::send_package); wszyscy pełni -> NO_RECEIVER.
+    std::uint32_t choose(std::size_t i) const;
+
+    // Odpowiednik PackageSender::send_package() dla nadawcy o indeksie i
+    void send(std::size_t i) const;
+
+    // Dostarcza paczkę odbiorcy wskazanemu uchwytem
+    void dispatch(ReceiverHandle h, Package&& p) const;
+
+private:
+    std::uint64_t generation_;
+
+    std::vector<Ramp*> ramps_;
+    std::vector<Worker*> workers_;
+    std::vector<Storehouse*> storehouses_;
+    std::vector<PackageSender*> senders_;   // rampy, potem robotnicy
+    bool bounded_ = false;
+
+    std::vector<TimeOffset> delivery_intervals_;
+
+    std::vector<std::uint32_t> offsets_;
+    std::vector<ReceiverHandle> successors_;
+    std::vector<double> weights_;
+};
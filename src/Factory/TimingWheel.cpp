@@ -0,0 +1,94 @@
+#include "TimingWheel.hpp"
+
+#include <stdexcept>
+#include <limits>
+
+TimingWheel::TimingWheel(std::size_t slots)
+    : wheel_count_(0), cursor_(0) {
+    if (slots == 0 || (slots & (slots - 1)) != 0) {
+        throw std::invalid_argument("Wheel size must be a power of two");
+    }
+    slots_.resize(slots);
+    mask_ = slots - 1;
+}
+
+std::size_t TimingWheel::slot_of(Time t) const {
+    return static_cast<std::size_t>(t) & mask_;
+}
+
+void TimingWheel::reset(Time now) {
+    for (auto& slot : slots_) {
+        slot.clear();
+    }
+    overflow_ = decltype(overflow_)();
+    wheel_count_ = 0;
+    cursor_ = now;
+}
+
+void TimingWheel::schedule(Time due, std::size_t item) {
+    if (due <= cursor_) {
+        throw std::logic_error("Timing wheel entry in the past");
+    }
+
+    // Niezmiennik koła: cursor_ < termin <= cursor_ + W
+    if (static_cast<std::size_t>(due - cursor_) <= slots_.size()) {
+        slots_[slot_of(due)].emplace_back(due, item);
+        ++wheel_count_;
+    } else {
+        overflow_.emplace(due, item);
+    }
+}
+
+void TimingWheel::advance(Time t, std::vector<entry_t>& out) {
+    if (t <= cursor_) return;
+
+    // 1️⃣ Koło: wszystkie jego terminy są <= cursor_ + W
+    Time last = (static_cast<std::size_t>(t - cursor_) < slots_.size())
+        ? t
+        : cursor_ + static_cast<Time>(slots_.size());
+
+    for (Time tick = cursor_ + 1; tick <= last && wheel_count_ > 0; ++tick) {
+        auto& slot = slots_[slot_of(tick)];
+        if (slot.empty()) continue;
+
+        wheel_count_ -= slot.size();
+        out.insert(out.end(), slot.begin(), slot.end());
+        slot.clear();
+    }
+    cursor_ = t;
+
+    // 2️⃣ Kopiec: zaległe terminy na wyjście, bliskie na koło
+    while (!overflow_.empty() && overflow_.top().first <= t) {
+        out.push_back(overflow_.top());
+        overflow_.pop();
+    }
+    while (!overflow_.empty() &&
+           static_cast<std::size_t>(overflow_.top().first - cursor_) <= slots_.size()) {
+        slots_[slot_of(overflow_.top().first)].push_back(overflow_.top());
+        ++wheel_count_;
+        overflow_.pop();
+    }
+}
+
+bool TimingWheel::empty() const {
+    return wheel_count_ == 0 && overflow_.empty();
+}
+
+Time TimingWheel::next_due() const {
+    if (wheel_count_ > 0) {
+        for (std::size_t i = 1; i <= slots_.size(); ++i) {
+            const auto& slot = slots_[slot_of(cursor_ + static_cast<Time>(i))];
+            if (!slot.empty()) {
+                return slot.front().first;
+            }
+        }
+    }
+    if (!overflow_.empty()) {
+        return overflow_.top().first;
+    }
+    return std::numeric_limits<Time>::max();
+}
+
+Time TimingWheel::now() const {
+    return cursor_;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+// ==============================
+// TimingWheel.hpp
+// ==============================
+// Koło czasowe terminów (np. dostaw na rampach)
+//
+// Dwa poziomy:
+// - koło W slotów dla terminów z najbliższych W tur (slot = termin mod W)
+// - kopiec dla terminów dalszych, przenoszonych na koło gdy się zbliżą
+//
+// advance(t) zwraca tylko elementy z terminem <= t, więc koszt tury
+// zależy od liczby wyzwolonych elementów, a nie od liczby wszystkich.
+// ==============================
+
+#include <cstddef>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "Package/Package.hpp"
+
+class TimingWheel {
+public:
+    using entry_t = std::pair<Time, std::size_t>; // (termin, element)
+
+    explicit TimingWheel(std::size_t slots = 256);
+
+    // Czyści koło; kolejne terminy muszą być > now
+    void reset(Time now);
+
+    // Planuje element na turę due (due > bieżąca tura koła)
+    void schedule(Time due, std::size_t item);
+
+    // Przesuwa koło do tury t i dopisuje do out elementy z terminem <= t
+    void advance(Time t, std::vector<entry_t>& out);
+
+    // Najbliższy zaplanowany termin (lub brak)
+    bool empty() const;
+    Time next_due() const;
+
+    Time now() const;
+
+private:
+    std::vector<std::vector<entry_t>> slots_;
+    std::size_t mask_;
+    std::size_t wheel_count_; // liczba elementów na kole
+
+    std::priority_queue<entry_t, std::vector<entry_t>, std::greater<entry_t>> overflow_;
+
+    Time cursor_; // ostatnia przetworzona tura
+
+    std::size_t slot_of(Time t) const;
+};
@@ -0,0 +1,192 @@
+#include "WorkStealing.hpp"
+#include "Affinity.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsed_ms(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+// =======================================================
+// Tworzenie / zamykanie puli
+// =======================================================
+
+WorkStealingPool::WorkStealingPool(unsigned threads)
+    : WorkStealingPool(threads, {}) {}
+
+WorkStealingPool::WorkStealingPool(unsigned threads, const std::vector<int>& cpus)
+    : cpus_(cpus) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (!cpus_.empty() && cpus_.size() != threads) {
+        throw std::invalid_argument("One CPU per pool thread required");
+    }
+
+    if (!cpus_.empty()) {
+        caller_cpus_ = current_thread_cpus();
+        pin_current_thread({cpus_[0]});
+    }
+
+    for (unsigned k = 0; k < threads; ++k) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    stats_.resize(threads);
+
+    for (unsigned k = 1; k < threads; ++k) {
+        threads_.emplace_back(&WorkStealingPool::thread_loop, this, k);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& t : threads_) {
+        t.join();
+    }
+    if (!caller_cpus_.empty()) {
+        pin_current_thread(caller_cpus_);
+    }
+}
+
+unsigned WorkStealingPool::size() const {
+    return static_cast<unsigned>(queues_.size());
+}
+
+const std::vector<StealStats>& WorkStealingPool::stats() const {
+    return stats_;
+}
+
+void WorkStealingPool::reset_stats() {
+    std::fill(stats_.begin(), stats_.end(), StealStats{});
+}
+
+// =======================================================
+// Faza
+// =======================================================
+
+void WorkStealingPool::run(
+    const std::vector<StealTask>& tasks,
+    const std::function<void(const StealTask&, unsigned)>& body
+) {
+    if (tasks.empty()) return;
+
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        queues_[tasks[i].home % queues_.size()]->tasks.push_back(i);
+    }
+    tasks_ = &tasks;
+    body_ = &body;
+    remaining_.store(tasks.size());
+    error_ = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        finished_ = 0;
+        ++phase_;
+    }
+    start_cv_.notify_all();
+
+    execute(0);
+
+    {
+        std::unique_lock<std::mutex> lock(m_);
+        done_cv_.wait(lock, [this] { return finished_ == threads_.size(); });
+    }
+
+    tasks_ = nullptr;
+    body_ = nullptr;
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+void WorkStealingPool::thread_loop(unsigned id) {
+    if (!cpus_.empty()) {
+        pin_current_thread({cpus_[id]});
+    }
+
+    std::uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_);
+            start_cv_.wait(lock, [&] { return stop_ || phase_ != seen; });
+            if (stop_) return;
+            seen = phase_;
+        }
+
+        execute(id);
+
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            ++finished_;
+        }
+        done_cv_.notify_one();
+    }
+}
+
+// Zadania własne, potem kradzieże, aż faza nie ma niewykonanych zadań
+void WorkStealingPool::execute(unsigned id) {
+    StealStats& st = stats_[id];
+    Clock::time_point idle_from = Clock::now();
+
+    while (remaining_.load(std::memory_order_acquire) > 0) {
+        std::size_t task;
+        bool stolen = false;
+        if (!pop_local(id, task)) {
+            if (!steal(id, task)) {
+                ++st.failed_steals;
+                std::this_thread::yield();
+                continue;
+            }
+            stolen = true;
+        }
+
+        Clock::time_point start = Clock::now();
+        st.idle_ms += elapsed_ms(idle_from, start);
+        if (stolen) ++st.steals;
+
+        try {
+            (*body_)((*tasks_)[task], id);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(error_m_);
+            if (!error_) error_ = std::current_exception();
+        }
+
+        idle_from = Clock::now();
+        st.busy_ms += elapsed_ms(start, idle_from);
+        ++st.tasks;
+        remaining_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    st.idle_ms += elapsed_ms(idle_from, Clock::now());
+}
+
+bool WorkStealingPool::pop_local(unsigned id, std::size_t& task) {
+    Queue& q = *queues_[id];
+    std::lock_guard<std::mutex> lock(q.m);
+    if (q.tasks.empty()) return false;
+    task = q.tasks.back();
+    q.tasks.pop_back();
+    return true;
+}
+
+// Najstarsze zadanie pierwszego niepustego wątku po id
+bool WorkStealingPool::steal(unsigned id, std::size_t& task) {
+    const unsigned n = size();
+    for (unsigned k = 1; k < n; ++k) {
+        Queue& q = *queues_[(id + k) % n];
+        std::lock_guard<std::mutex> lock(q.m);
+        if (q.tasks.empty()) continue;
+        task = q.tasks.front();
+        q.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+// ==============================
+// WorkStealing.hpp
+// ==============================
+// Pula wątków z podkradaniem zadań dla równoległych faz tury
+//
+// Odpowiada za:
+// - kolejkę zadań na wątek: zadanie trafia najpierw do wątku home
+//   (np. część grafu fabryki), właściciel bierze zadania od końca
+// - podkradanie: wątek bez zadań zabiera najstarsze zadanie innego wątku
+// - barierę fazy: run() wraca, gdy wszystkie zadania są wykonane
+// - liczniki na wątek: zadania, kradzieże, czas pracy i bezczynności
+// - opcjonalne przypięcie wątków do rdzeni (cpus[k] -> wątek k)
+//
+// Wątek wywołujący run() jest wątkiem 0 puli. Przy przypięciu jest to
+// wątek tworzący pulę; jego poprzedni zbiór procesorów wraca w destruktorze.
+// ==============================
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// =======================================================
+// Zadanie i liczniki
+// =======================================================
+
+struct StealTask {
+    std::size_t begin;   // zakres elementów [begin, end)
+    std::size_t end;
+    unsigned home;       // wątek początkowy (modulo rozmiar puli)
+};
+
+struct StealStats {
+    std::uint64_t tasks = 0;           // wykonane zadania
+    std::uint64_t steals = 0;          // zadania zabrane innym wątkom
+    std::uint64_t failed_steals = 0;   // przeszukania bez znalezionego zadania
+    double busy_ms = 0.0;              // czas wykonywania zadań
+    double idle_ms = 0.0;              // czas w fazie bez zadania (szukanie, czekanie)
+};
+
+// =======================================================
+// WorkStealingPool
+// =======================================================
+
+class WorkStealingPool {
+public:
+    // threads == 0 -> std::thread::hardware_concurrency()
+    explicit WorkStealingPool(unsigned threads = 0);
+    // cpus.size() == threads (puste -> bez przypięcia)
+    WorkStealingPool(unsigned threads, const std::vector<int>& cpus);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned size() const;
+
+    // Wykonuje body(zadanie, wątek) dla wszystkich zadań (jedna faza).
+    // Pierwszy wyjątek z body jest zgłaszany po zakończeniu fazy.
+    void run(const std::vector<StealTask>& tasks,
+             const std::function<void(const StealTask&, unsigned)>& body);
+
+    // Liczniki od utworzenia puli / reset_stats()
+    const std::vector<StealStats>& stats() const;
+    void reset_stats();
+
+private:
+    struct Queue {
+        std::mutex m;
+        std::deque<std::size_t> tasks;   // indeksy zadań fazy
+    };
+
+    void thread_loop(unsigned id);
+    void execute(unsigned id);
+    bool pop_local(unsigned id, std::size_t& task);
+    bool steal(unsigned id, std::size_t& task);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+    std::vector<StealStats> stats_;
+    std::vector<int> cpus_;           // rdzeń wątku (puste -> bez przypięcia)
+    std::vector<int> caller_cpus_;    // zbiór wątku 0 sprzed przypięcia
+
+    // stan fazy
+    std::mutex m_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    std::uint64_t phase_ = 0;
+    unsigned finished_ = 0;
+    bool stop_ = false;
+
+    const std::vector<StealTask>* tasks_ = nullptr;
+    const std::function<void(const StealTask&, unsigned)>* body_ = nullptr;
+    std::atomic<std::size_t> remaining_{0};   // niewykonane zadania fazy
+    std::mutex error_m_;
+    std::exception_ptr error_;
+};
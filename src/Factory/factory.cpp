@@ -63,34 +63,56 @@ NodeCollection<Node>::cend() const {
     return nodes_.cend();
 }
 
+// =======================================================
+// Factory – przeniesienie
+// =======================================================
+
+Factory& Factory::operator=(Factory&& other) {
+    if (this != &other) {
+        ramps_ = std::move(other.ramps_);
+        workers_ = std::move(other.workers_);
+        storehouses_ = std::move(other.storehouses_);
+        schedule_ = std::move(other.schedule_);
+        other.schedule_ = std::make_unique<Schedule>();
+        schedule_->dirty = true;
+    }
+    return *this;
+}
+
 // =======================================================
 // Factory – dodawanie / usuwanie
 // =======================================================
 
 void Factory::add_ramp(Ramp&& ramp) {
     ramps_.add(std::move(ramp));
+    schedule_->dirty = true;
 }
 
 void Factory::add_worker(Worker&& worker) {
     workers_.add(std::move(worker));
+    schedule_->dirty = true;
 }
 
 void Factory::add_storehouse(Storehouse&& storehouse) {
     storehouses_.add(std::move(storehouse));
+    schedule_->dirty = true;
 }
 
 void Factory::remove_ramp(ElementID id) {
     ramps_.remove_by_id(id);
+    schedule_->dirty = true;
 }
 
 void Factory::remove_worker(ElementID id) {
     remove_receiver(workers_, id);
     workers_.remove_by_id(id);
+    schedule_->dirty = true;
 }
 
 void Factory::remove_storehouse(ElementID id) {
     remove_receiver(storehouses_, id);
     storehouses_.remove_by_id(id);
+    schedule_->dirty = true;
 }
 
 // =======================================================
@@ -103,18 +125,36 @@ Factory::ramp_cbegin() const { return ramps_.cbegin(); }
 NodeCollection<Ramp>::const_iterator
 Factory::ramp_cend() const { return ramps_.cend(); }
 
+NodeCollection<Ramp>::iterator
+Factory::ramp_begin() { return ramps_.begin(); }
+
+NodeCollection<Ramp>::iterator
+Factory::ramp_end() { return ramps_.end(); }
+
 NodeCollection<Worker>::const_iterator
 Factory::worker_cbegin() const { return workers_.cbegin(); }
 
 NodeCollection<Worker>::const_iterator
 Factory::worker_cend() const { return workers_.cend(); }
 
+NodeCollection<Worker>::iterator
+Factory::worker_begin() { return workers_.begin(); }
+
+NodeCollection<Worker>::iterator
+Factory::worker_end() { return workers_.end(); }
+
 NodeCollection<Storehouse>::const_iterator
 Factory::storehouse_cbegin() const { return storehouses_.cbegin(); }
 
 NodeCollection<Storehouse>::const_iterator
 Factory::storehouse_cend() const { return storehouses_.cend(); }
 
+NodeCollection<Storehouse>::iterator
+Factory::storehouse_begin() { return storehouses_.begin(); }
+
+NodeCollection<Storehouse>::iterator
+Factory::storehouse_end() { return storehouses_.end(); }
+
 // =======================================================
 // Usuwanie odbiorcy z preferencji
 // =======================================================
@@ -179,82 +219,369 @@ void Factory::remove_receiver(NodeCollection<Node>& collection, ElementID id) {
 }
 
 // =======================================================
-// Spójność sieci (DFS)
+// Spójność sieci (BFS wstecz od magazynów)
 // =======================================================
+//
+// Węzeł jest "dobry", gdy z niego da się dojść do magazynu. Przejście
+// wstecz po łączach od nadawców połączonych z magazynem odwiedza każdy
+// węzeł i łącze raz -> O(V + E), bez względu na liczbę ramp i cykle.
 
 bool Factory::is_consistent() const {
-    std::map<const PackageSender*, bool> visited;
+    // odwrócone łącza: robotnik -> nadawcy, którzy do niego wysyłają
+    std::unordered_map<const PackageSender*, std::vector<const PackageSender*>> senders_of;
+    std::unordered_set<const PackageSender*> verified;
+    std::vector<const PackageSender*> queue;
+
+    auto add_edges = [&](const PackageSender* sender) {
+        const auto& prefs = sender->receiver_preferences.get_preferences();
+        if (prefs.empty()) {
+            throw std::logic_error("Sender has no receivers");
+        }
+        for (const auto& kv : prefs) {
+            IPackageReceiver* receiver = kv.first;
+            if (receiver->get_receiver_type() == ReceiverType::STOREHOUSE) {
+                if (verified.insert(sender).second) {
+                    queue.push_back(sender);
+                }
+            } else {
+                // ReceiverType::WORKER gwarantuje typ Worker -> bez RTTI
+                senders_of[static_cast<const Worker*>(receiver)].push_back(sender);
+            }
+        }
+    };
+    for (auto it = ramps_.cbegin(); it != ramps_.cend(); ++it) add_edges(&(*it));
+    for (auto it = workers_.cbegin(); it != workers_.cend(); ++it) add_edges(&(*it));
+
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        auto found = senders_of.find(queue[head]);
+        if (found == senders_of.end()) {
+            continue;
+        }
+        for (const PackageSender* sender : found->second) {
+            if (verified.insert(sender).second) {
+                queue.push_back(sender);
+            }
+        }
+    }
 
     for (auto it = ramps_.cbegin(); it != ramps_.cend(); ++it) {
-        if (!has_reachable_storehouse(&(*it), visited)) {
+        if (verified.count(&(*it)) == 0) {
             return false;
         }
     }
     return true;
 }
 
-bool Factory::has_reachable_storehouse(
-    const PackageSender* sender,
-    std::map<const PackageSender*, bool>& visited
-) const {
-    if (visited[sender]) {
-        return false;
+// Etapy symulacji
+
+// 1️⃣ Dostawy na rampach
+// Koło czasowe wyzwala tylko rampy, które mają dostawę w turze t
+void Factory::do_deliveries(Time t) {
+    refresh_schedule();
+
+    Schedule& s = *schedule_;
+    s.now = t;
+    if (s.deliveries_dirty || t <= s.deliveries.now()) {
+        rebuild_deliveries(t);
     }
-    visited[sender] = true;
 
-    const auto& prefs = sender->receiver_preferences.get_preferences();
-    if (prefs.empty()) {
-        throw std::logic_error("Sender has no receivers");
+    s.due.clear();
+    s.deliveries.advance(t, s.due);
+
+    // ta sama kolejność co w kolekcji ramp (kolejność nadawania ID paczek)
+    std::sort(s.due.begin(), s.due.end(),
+        [](const TimingWheel::entry_t& a, const TimingWheel::entry_t& b) {
+            return a.second < b.second;
+        });
+
+    const FactorySnapshot& snap = *s.snapshot;
+    for (const auto& entry : s.due) {
+        Ramp* ramp = snap.ramps()[entry.second];
+
+        // pominięte tury (skok czasu) -> następny termin >= t
+        if (ramp->next_delivery_time(t) == t) {
+            ramp->deliver_goods(t);
+        }
+        Time next = ramp->next_delivery_time(t + 1);
+        if (next != Ramp::NO_DELIVERY) {
+            s.deliveries.schedule(next, entry.second);
+        }
     }
 
-    for (const auto& kv : prefs) {
-        IPackageReceiver* receiver = kv.first;
+    // zegar magazynów -> paczki przyjęte w tej turze dostają czas t
+    for (Storehouse* store : snap.storehouses()) {
+        store->set_time(t);
+    }
+}
 
-        if (receiver->get_receiver_type() == ReceiverType::STOREHOUSE) {
-            return true;
+// 2️⃣ Przekazywanie paczek (nadawcy -> odbiorcy)
+// Tylko nadawcy z zajętym buforem, w kolejności: rampy, potem robotnicy
+void Factory::do_package_passing() {
+    refresh_schedule();
+
+    const FactorySnapshot& snap = *schedule_->snapshot;
+    auto& batch = schedule_->batch;
+    schedule_->active_senders.drain_sorted(batch);
+
+    for (std::size_t i : batch) {
+        snap.send(i);
+
+        // nie wylosowano odbiorcy -> paczka czeka do następnej tury
+        if (snap.senders()[i]->has_package()) {
+            schedule_->active_senders.insert(i);
         }
+    }
+}
 
-        if (receiver->get_receiver_type() == ReceiverType::WORKER) {
-            const Worker* worker =
-                dynamic_cast<const Worker*>(receiver);
+void Factory::do_package_passing(WorkStealingPool& pool) {
+    refresh_schedule();
 
-            if (worker) {
-                const PackageSender* next = worker;
-                if (has_reachable_storehouse(next, visited)) {
-                    return true;
-                }
+    Schedule& s = *schedule_;
+    const FactorySnapshot& snap = *s.snapshot;
+
+    // ograniczone kolejki: przyjęcie zależy od paczek wcześniejszych
+    // nadawców tej tury -> kolejno, jak bez puli
+    if (snap.has_bounded_queues()) {
+        do_package_passing();
+        return;
+    }
+    auto& batch = s.batch;
+    s.active_senders.drain_sorted(batch);
+    if (batch.empty()) return;
+
+    const unsigned threads = pool.size();
+    const std::size_t worker_count = snap.workers().size();
+    s.touched.resize(threads);
+
+    // zadania: równe bloki nadawców, kilka na wątek
+    const std::size_t grain = std::max<std::size_t>(1, batch.size() / (4 * threads));
+    std::vector<StealTask> tasks;
+    for (std::size_t k = 0; k < batch.size(); k += grain) {
+        tasks.push_back(StealTask{k, std::min(k + grain, batch.size()),
+                                  static_cast<unsigned>(k * threads / batch.size())});
+    }
+
+    auto inbox_of = [&](ReceiverHandle h) -> PackageInbox& {
+        return s.inboxes[(h.type == ReceiverType::WORKER) ? h.index : worker_count + h.index];
+    };
+
+    pool.run(tasks, [&](const StealTask& task, unsigned thread) {
+        for (std::size_t k = task.begin; k < task.end; ++k) {
+            const std::size_t i = batch[k];
+            std::uint32_t slot = snap.choose(i);
+            if (slot == FactorySnapshot::NO_RECEIVER) continue;
+
+            ReceiverHandle h = snap.successors()[slot];
+            InboxEntry& e = s.entries[i];
+            e.sender = static_cast<std::uint32_t>(i);
+            e.package.emplace(snap.senders()[i]->take_package());
+            if (inbox_of(h).push(&e)) {
+                s.touched[thread].push_back(h);
             }
         }
+    });
+
+    // granica fazy: skrzynki odbiorców, paczki rosnąco wg nadawcy
+    std::vector<InboxEntry*> drained;
+    for (auto& handles : s.touched) {
+        for (ReceiverHandle h : handles) {
+            inbox_of(h).drain(drained);
+            for (InboxEntry* e : drained) {
+                snap.dispatch(h, std::move(*e->package));
+                e->package.reset();
+            }
+        }
+        handles.clear();
     }
 
-    return false;
+    // nie wylosowano odbiorcy -> paczka czeka do następnej tury
+    for (std::size_t i : batch) {
+        if (snap.senders()[i]->has_package()) {
+            s.active_senders.insert(i);
+        }
+    }
 }
 
-// Etapy symulacji
+// 3️⃣ Praca robotników
+// Tylko robotnicy z paczką w obróbce lub w kolejce
+void Factory::do_work(Time t) {
+    refresh_schedule();
 
-// 1️⃣ Dostawy na rampach
-void Factory::do_deliveries(Time t) {
-    for (auto it = ramps_.begin(); it != ramps_.end(); ++it) {
-        it->deliver_goods(t);
+    auto& batch = schedule_->batch;
+    schedule_->active_workers.drain_sorted(batch);
+
+    const FactorySnapshot& snap = *schedule_->snapshot;
+    for (std::size_t i : batch) {
+        Worker* worker = snap.workers()[i];
+        worker->do_work(t);
+
+        if (worker->has_work()) {
+            schedule_->active_workers.insert(i);
+        }
     }
 }
 
-// 2️⃣ Przekazywanie paczek (nadawcy -> odbiorcy)
-void Factory::do_package_passing() {
-    for (auto it = ramps_.begin(); it != ramps_.end(); ++it) {
-        it->send_package();
+void Factory::do_work(Time t, WorkStealingPool& pool, const std::vector<std::size_t>& home) {
+    refresh_schedule();
+
+    Schedule& s = *schedule_;
+    const FactorySnapshot& snap = *s.snapshot;
+    auto& batch = s.batch;
+    s.active_workers.drain_sorted(batch);
+    if (batch.empty()) return;
+
+    const unsigned threads = pool.size();
+    auto part_of = [&](std::size_t i) -> std::size_t {
+        return home.empty() ? i * threads / snap.workers().size() : home[i] % threads;
+    };
+
+    // robotnicy części po kolei (stabilnie -> rosnąco w części)
+    std::vector<std::size_t> order(batch);
+    std::stable_sort(order.begin(), order.end(),
+        [&](std::size_t a, std::size_t b) { return part_of(a) < part_of(b); });
+
+    // zadania: ciągłe fragmenty jednej części o koszcie ~ total / (4 * wątki)
+    std::size_t total = 0;
+    for (std::size_t i : order) total += 1 + snap.workers()[i]->get_queue()->size();
+    const std::size_t grain = std::max<std::size_t>(1, total / (4 * threads));
+
+    std::vector<StealTask> tasks;
+    std::size_t cost = 0;
+    for (std::size_t k = 0; k < order.size(); ++k) {
+        const unsigned part = static_cast<unsigned>(part_of(order[k]));
+        if (tasks.empty() || tasks.back().home != part || cost >= grain) {
+            tasks.push_back(StealTask{k, k, part});
+            cost = 0;
+        }
+        tasks.back().end = k + 1;
+        cost += 1 + snap.workers()[order[k]]->get_queue()->size();
     }
 
-    for (auto it = workers_.begin(); it != workers_.end(); ++it) {
-        it->send_package();
+    // po fazie: zgłoszenia do zbiorów aktywnych (zbiory nie są wątkowo bezpieczne)
+    const std::size_t first_worker = snap.ramps().size();
+    auto reattach = [&] {
+        for (std::size_t i : batch) {
+            Worker* worker = snap.workers()[i];
+            worker->attach_sender_set(&s.active_senders, first_worker + i);
+            if (worker->has_package()) {
+                s.active_senders.insert(first_worker + i);
+            }
+            if (worker->has_work()) {
+                s.active_workers.insert(i);
+            }
+        }
+    };
+
+    try {
+        pool.run(tasks, [&](const StealTask& task, unsigned) {
+            for (std::size_t k = task.begin; k < task.end; ++k) {
+                Worker* worker = snap.workers()[order[k]];
+                worker->attach_sender_set(nullptr, 0);
+                worker->do_work(t);
+            }
+        });
+    } catch (...) {
+        reattach();
+        throw;
     }
+    reattach();
 }
 
-// 3️⃣ Praca robotników
-void Factory::do_work(Time t) {
+Time Factory::next_event_time(Time t) {
+    refresh_schedule();
+
+    Schedule& s = *schedule_;
+    if (s.deliveries_dirty || t < s.deliveries.now()) {
+        rebuild_deliveries(t + 1);
+    }
+
+    // najbliższa dostawa na którejkolwiek rampie
+    Time next = std::max(s.deliveries.next_due(), t + 1);
+
+    if (!s.active_senders.empty()) {
+        return t + 1;
+    }
+
+    for (std::size_t i : s.active_workers.members()) {
+        next = std::min(next, s.snapshot->workers()[i]->next_work_time(t));
+    }
+
+    return next;
+}
+
+void Factory::rebuild_deliveries(Time t) {
+    Schedule& s = *schedule_;
+    s.deliveries.reset(t - 1);
+
+    const auto& ramps = s.snapshot->ramps();
+    for (std::size_t i = 0; i < ramps.size(); ++i) {
+        if (!ramps[i]->get_trace() && ramps[i]->get_delivery_interval() <= 0) {
+            throw std::logic_error("Invalid delivery interval");
+        }
+        Time next = ramps[i]->next_delivery_time(t);
+        if (next != Ramp::NO_DELIVERY) {
+            s.deliveries.schedule(next, i);
+        }
+    }
+    s.deliveries_dirty = false;
+}
+
+const FactorySnapshot& Factory::snapshot() {
+    refresh_schedule();
+    return *schedule_->snapshot;
+}
+
+void Factory::invalidate() {
+    schedule_->dirty = true;
+}
+
+// Kompiluje obraz topologii i wyznacza zbiory aktywne z bieżącego stanu
+void Factory::refresh_schedule() {
+    if (!schedule_->dirty) return;
+
+    Schedule& s = *schedule_;
+    std::vector<Ramp*> ramps;
+    std::vector<Worker*> workers;
+    std::vector<Storehouse*> storehouses;
+    for (auto it = ramps_.begin(); it != ramps_.end(); ++it) {
+        ramps.push_back(&(*it));
+    }
     for (auto it = workers_.begin(); it != workers_.end(); ++it) {
-        it->do_work(t);
+        workers.push_back(&(*it));
+    }
+    for (auto it = storehouses_.begin(); it != storehouses_.end(); ++it) {
+        storehouses.push_back(&(*it));
+    }
+
+    // obraz musi powstać przed wyczyszczeniem flagi (wyjątek -> ponowna próba)
+    s.snapshot = std::make_unique<const FactorySnapshot>(
+        std::move(ramps), std::move(workers), std::move(storehouses), ++s.generation);
+    const FactorySnapshot& snap = *s.snapshot;
+
+    s.entries = std::vector<InboxEntry>(snap.senders().size());
+    s.inboxes.reset(new PackageInbox[snap.workers().size() + snap.storehouses().size()]);
+
+    s.active_senders.reset(snap.senders().size());
+    s.active_workers.reset(snap.workers().size());
+
+    for (std::size_t i = 0; i < snap.senders().size(); ++i) {
+        PackageSender* sender = snap.senders()[i];
+        sender->attach_sender_set(&s.active_senders, i);
+        if (sender->has_package()) {
+            s.active_senders.insert(i);
+        }
     }
+    for (std::size_t i = 0; i < snap.workers().size(); ++i) {
+        Worker* worker = snap.workers()[i];
+        worker->attach_worker_set(&s.active_workers, i);
+        worker->attach_clock(&s.now);
+        if (worker->has_work()) {
+            s.active_workers.insert(i);
+        }
+    }
+
+    s.dirty = false;
+    s.deliveries_dirty = true;
 }
 
 // // ===== kolory DFS =====
@@ -1,15 +1,24 @@
 #pragma once
 #include <list>
 #include <map>
+#include <memory_resource>
 #include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 #include "Nodes/Nodes.hpp"
+#include "Factory/Inbox.hpp"
+#include "Factory/Snapshot.hpp"
+#include "Factory/TimingWheel.hpp"
+#include "Factory/WorkStealing.hpp"
 
 template <typename Node>
 class NodeCollection {
 public:
-    using container_t = std::list<Node>;
+    using container_t = std::pmr::list<Node>;
     using iterator = typename container_t::iterator;
     using const_iterator = typename container_t::const_iterator;
 
@@ -37,6 +46,13 @@ private:
 
 class Factory {
 public:
+    Factory() = default;
+    Factory(Factory&&) = default;
+
+    // Węzły mogą zmienić adresy (różne zasoby pamięci list)
+    // -> obraz topologii kompilowany ponownie
+    Factory& operator=(Factory&& other);
+
     // --- API fabryki ---
     void add_ramp(Ramp&& r);
     void add_worker(Worker&& w);
@@ -49,28 +65,87 @@ public:
     NodeCollection<Ramp>::const_iterator ramp_cbegin() const;
     NodeCollection<Ramp>::const_iterator ramp_cend() const;
 
+    NodeCollection<Ramp>::iterator ramp_begin();
+    NodeCollection<Ramp>::iterator ramp_end();
+
     NodeCollection<Worker>::const_iterator worker_cbegin() const;
     NodeCollection<Worker>::const_iterator worker_cend() const;
 
+    NodeCollection<Worker>::iterator worker_begin();
+    NodeCollection<Worker>::iterator worker_end();
+
     NodeCollection<Storehouse>::const_iterator storehouse_cbegin() const;
     NodeCollection<Storehouse>::const_iterator storehouse_cend() const;
+
+    NodeCollection<Storehouse>::iterator storehouse_begin();
+    NodeCollection<Storehouse>::iterator storehouse_end();
+
     bool is_consistent() const;
 
+    // Skompilowany obraz topologii (kompilowany ponownie po zmianie).
+    // Ważny do następnej zmiany topologii fabryki.
+    const FactorySnapshot& snapshot();
+
+    // Wymusza ponowną kompilację obrazu, np. po zmianie preferencji
+    // odbiorców poza API fabryki (add_* / remove_* robią to same)
+    void invalidate();
+
     // „hooki” z UML (puste na tym etapie)
     void do_deliveries(Time);
     void do_package_passing();
     void do_work(Time);
 
+    // Przekazywanie paczek na puli wątków: nadawcy losują odbiorców
+    // równolegle i dopisują paczki do skrzynek odbiorców (PackageInbox),
+    // skrzynki są opróżniane po fazie rosnąco wg nadawcy.
+    // Wynik jak do_package_passing(). Generatory prawdopodobieństwa
+    // nadawców nie mogą współdzielić stanu.
+    void do_package_passing(WorkStealingPool& pool);
+
+    // Praca robotników na puli wątków: aktywni robotnicy pogrupowani wg
+    // home[i] (część grafu robotnika i; puste -> bloki indeksów), zadania
+    // o zbliżonym koszcie (1 + długość kolejki). Wynik jak do_work(t).
+    // Kolejki robotników muszą używać zasobu pamięci bezpiecznego wątkowo.
+    void do_work(Time t, WorkStealingPool& pool, const std::vector<std::size_t>& home);
+
+    // Najbliższa tura > t, w której któraś faza może coś zmienić
+    // (dostawa, zajęty bufor nadawcy, start lub koniec pracy robotnika).
+    // Tury pomiędzy można pominąć bez zmiany przebiegu symulacji.
+    Time next_event_time(Time t);
+
 private:
     NodeCollection<Ramp> ramps_;
     NodeCollection<Worker> workers_;
     NodeCollection<Storehouse> storehouses_;
 
+    // Zbiory aktywnych węzłów: fazy iterują tylko po węzłach,
+    // które mogą coś zrobić (na stercie -> adresy stałe przy przenoszeniu Factory)
+    struct Schedule {
+        std::unique_ptr<const FactorySnapshot> snapshot;
+        std::uint64_t generation = 0;        // liczba kompilacji obrazu
+        ActiveSet active_senders;            // zajęty bufor nadawcy
+        ActiveSet active_workers;            // paczka w obróbce lub w kolejce
+        std::vector<std::size_t> batch;      // bieżąca faza (rosnąco)
+
+        // Równoległe przekazywanie: wpis na nadawcę, skrzynka na odbiorcę
+        // (robotnicy, potem magazyny), odbiorcy z paczkami na wątek puli
+        std::vector<InboxEntry> entries;
+        std::unique_ptr<PackageInbox[]> inboxes;
+        std::vector<std::vector<ReceiverHandle>> touched;
+        bool dirty = true;                   // zmiana topologii -> przebudowa
+        Time now = 0;                        // bieżąca tura (zegar robotników)
+
+        // Terminy dostaw ramp (element = indeks rampy)
+        TimingWheel deliveries;
+        std::vector<TimingWheel::entry_t> due;
+        bool deliveries_dirty = true;
+    };
+    std::unique_ptr<Schedule> schedule_ = std::make_unique<Schedule>();
+
+    void refresh_schedule();
+    void rebuild_deliveries(Time t); // koło ustawione na turę t - 1
+
     // prywatna metoda pomocnicza
     template <typename Node>
     void remove_receiver(NodeCollection<Node>& collection, ElementID id);
-    bool has_reachable_storehouse(
-    const PackageSender* sender,
-    std::map<const PackageSender*, bool>& visited
-    ) const;
 };
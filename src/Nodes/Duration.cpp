@@ -0,0 +1,269 @@
+#include "Duration.hpp"
+#include "RandomStream.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+// =======================================================
+// Funkcje pomocnicze
+// =======================================================
+
+// Czas ciągły -> pełne tury (w górę, co najmniej 1; najwyżej pół zakresu,
+// więc tura + czas mieści się w Time)
+static TimeOffset to_turns(double x) {
+    const TimeOffset limit = std::numeric_limits<TimeOffset>::max() / 2;
+    if (!(x < limit)) {
+        return limit;
+    }
+    return std::max<TimeOffset>(static_cast<TimeOffset>(std::ceil(x)), 1);
+}
+
+// =======================================================
+// DurationDistribution
+// =======================================================
+
+DurationDistribution::DurationDistribution(TimeOffset value)
+    : a_(static_cast<double>(value)) {}
+
+DurationDistribution DurationDistribution::exponential(double mean) {
+    if (!(mean > 0.0)) {
+        throw std::invalid_argument("Exponential mean must be positive");
+    }
+    DurationDistribution d;
+    d.kind_ = DurationKind::EXPONENTIAL;
+    d.a_ = mean;
+    return d;
+}
+
+DurationDistribution DurationDistribution::uniform(TimeOffset low, TimeOffset high) {
+    if (low < 1 || high < low) {
+        throw std::invalid_argument("Uniform range must satisfy 1 <= low <= high");
+    }
+    DurationDistribution d;
+    d.kind_ = DurationKind::UNIFORM;
+    d.a_ = low;
+    d.b_ = high;
+    return d;
+}
+
+DurationDistribution DurationDistribution::empirical(
+    std::vector<TimeOffset> values,
+    std::vector<double> weights
+) {
+    if (values.empty() || values.size() != weights.size()) {
+        throw std::invalid_argument("Empirical table needs one weight per value");
+    }
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (values[i] < 1 || !(weights[i] >= 0.0)) {
+            throw std::invalid_argument("Empirical values must be positive, weights non-negative");
+        }
+    }
+    const double total = std::accumulate(weights.begin(), weights.end(), 0.0);
+    if (!(total > 0.0)) {
+        throw std::invalid_argument("Empirical weights must not all be zero");
+    }
+
+    DurationDistribution d;
+    d.kind_ = DurationKind::EMPIRICAL;
+    d.values_ = std::move(values);
+    d.weights_ = std::move(weights);
+
+    // tablica aliasów (Vose): kubełek i -> values_[i] z prawd. threshold_[i],
+    // w przeciwnym razie values_[alias_[i]]
+    const std::size_t n = d.values_.size();
+    std::vector<double> p(n);
+    std::vector<std::uint32_t> small, large;
+    for (std::size_t i = 0; i < n; ++i) {
+        p[i] = d.weights_[i] * static_cast<double>(n) / total;
+        (p[i] < 1.0 ? small : large).push_back(static_cast<std::uint32_t>(i));
+    }
+    d.threshold_.assign(n, 1.0);
+    d.alias_.resize(n);
+    std::iota(d.alias_.begin(), d.alias_.end(), 0u);
+    while (!small.empty() && !large.empty()) {
+        std::uint32_t s = small.back();
+        small.pop_back();
+        std::uint32_t l = large.back();
+        d.threshold_[s] = p[s];
+        d.alias_[s] = l;
+        p[l] -= 1.0 - p[s];
+        if (p[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    return d;
+}
+
+DurationDistribution DurationDistribution::lognormal(double mu, double sigma) {
+    if (!std::isfinite(mu) || !(sigma >= 0.0)) {
+        throw std::invalid_argument("Lognormal sigma must be non-negative");
+    }
+    DurationDistribution d;
+    d.kind_ = DurationKind::LOGNORMAL;
+    d.a_ = mu;
+    d.b_ = sigma;
+    return d;
+}
+
+DurationKind DurationDistribution::get_kind() const {
+    return kind_;
+}
+
+bool DurationDistribution::is_fixed() const {
+    return kind_ == DurationKind::FIXED;
+}
+
+double DurationDistribution::get_first() const {
+    return a_;
+}
+
+double DurationDistribution::get_second() const {
+    return b_;
+}
+
+const std::vector<TimeOffset>& DurationDistribution::get_values() const {
+    return values_;
+}
+
+const std::vector<double>& DurationDistribution::get_weights() const {
+    return weights_;
+}
+
+double DurationDistribution::mean() const {
+    switch (kind_) {
+        case DurationKind::FIXED:
+            return a_;
+        case DurationKind::EXPONENTIAL:
+            // ceil(X) ma rozkład geometryczny z p = 1 - e^(-1/mean)
+            return 1.0 / -std::expm1(-1.0 / a_);
+        case DurationKind::UNIFORM:
+            return (a_ + b_) / 2.0;
+        case DurationKind::EMPIRICAL: {
+            double sum = 0.0, total = 0.0;
+            for (std::size_t i = 0; i < values_.size(); ++i) {
+                sum += values_[i] * weights_[i];
+                total += weights_[i];
+            }
+            return sum / total;
+        }
+        case DurationKind::LOGNORMAL:
+            return std::exp(a_ + b_ * b_ / 2.0) + 0.5;
+    }
+    return a_;
+}
+
+TimeOffset DurationDistribution::nominal() const {
+    if (is_fixed()) {
+        return static_cast<TimeOffset>(a_);
+    }
+    return to_turns(std::round(mean()));
+}
+
+TimeOffset DurationDistribution::sample(std::uint64_t seed, std::uint64_t n) const {
+    TimeOffset value = 0;
+    sample_block(seed, n, 1, &value);
+    return value;
+}
+
+// Jedna pętla na rodzaj rozkładu, bez zależności między iteracjami
+// (pozycje strumienia liczone niezależnie) -> kompilator może ją wektoryzować
+void DurationDistribution::sample_block(
+    std::uint64_t seed,
+    std::uint64_t first,
+    std::size_t count,
+    TimeOffset* out
+) const {
+    switch (kind_) {
+        case DurationKind::FIXED: {
+            std::fill(out, out + count, static_cast<TimeOffset>(a_));
+            break;
+        }
+        case DurationKind::EXPONENTIAL: {
+            for (std::size_t k = 0; k < count; ++k) {
+                double u = RandomStream::value_at(seed, first + k);
+                out[k] = to_turns(-a_ * std::log1p(-u));
+            }
+            break;
+        }
+        case DurationKind::UNIFORM: {
+            const double span = b_ - a_ + 1.0;
+            for (std::size_t k = 0; k < count; ++k) {
+                double u = RandomStream::value_at(seed, first + k);
+                out[k] = static_cast<TimeOffset>(std::min(a_ + std::floor(u * span), b_));
+            }
+            break;
+        }
+        case DurationKind::EMPIRICAL: {
+            const double n = static_cast<double>(values_.size());
+            const std::size_t last = values_.size() - 1;
+            for (std::size_t k = 0; k < count; ++k) {
+                double x = RandomStream::value_at(seed, first + k) * n;
+                std::size_t i = std::min(static_cast<std::size_t>(x), last);
+                out[k] = (x - static_cast<double>(i) < threshold_[i]) ? values_[i] : values_[alias_[i]];
+            }
+            break;
+        }
+        case DurationKind::LOGNORMAL: {
+            // Box-Muller: wartość n z liczb na pozycjach 2n - 1 i 2n
+            const double two_pi = 6.283185307179586;
+            for (std::size_t k = 0; k < count; ++k) {
+                const std::uint64_t n = first + k;
+                double u1 = RandomStream::value_at(seed, 2 * n - 1);
+                double u2 = RandomStream::value_at(seed, 2 * n);
+                double z = std::sqrt(-2.0 * std::log1p(-u1)) * std::cos(two_pi * u2);
+                out[k] = to_turns(std::exp(a_ + b_ * z));
+            }
+            break;
+        }
+    }
+}
+
+// =======================================================
+// DurationStream
+// =======================================================
+
+DurationStream::DurationStream(TimeOffset value)
+    : distribution_(value) {}
+
+DurationStream::DurationStream(
+    DurationDistribution distribution,
+    std::uint64_t seed,
+    std::uint64_t position
+)
+    : distribution_(std::move(distribution)), seed_(seed), position_(position) {}
+
+TimeOffset DurationStream::next() {
+    if (distribution_.is_fixed()) {
+        return static_cast<TimeOffset>(distribution_.get_first());
+    }
+
+    ++position_;
+    if (position_ <= block_first_ || position_ > block_first_ + block_size_) {
+        // kolejny blok czasów naraz (pozycje position_ .. position_ + BLOCK - 1)
+        block_first_ = position_ - 1;
+        block_size_ = BLOCK;
+        distribution_.sample_block(seed_, position_, BLOCK, block_.data());
+    }
+    return block_[position_ - block_first_ - 1];
+}
+
+const DurationDistribution& DurationStream::get_distribution() const {
+    return distribution_;
+}
+
+std::uint64_t DurationStream::get_seed() const {
+    return seed_;
+}
+
+std::uint64_t DurationStream::get_position() const {
+    return position_;
+}
+
+void DurationStream::set_position(std::uint64_t position) {
+    position_ = position;
+}
@@ -0,0 +1,89 @@
+// Duration -> czasy obróbki robotników i odstępy dostaw ramp
+// {
+// DurationDistribution -> rozkład liczby tur: stały, wykładniczy, jednostajny,
+//                         empiryczny (tablica wartości z wagami), logarytmiczno-normalny
+// DurationStream       -> powtarzalny strumień czasów węzła: n-ta wartość zależy
+//                         tylko od (rozkład, ziarno, n), jak w RandomStream,
+//                         więc pozycję można zapisać i odtworzyć
+// }
+//
+// Wartości losowe są zaokrąglane w górę do pełnych tur (co najmniej 1).
+// Rozkład stały nie zużywa liczb losowych (pozycja strumienia zostaje 0).
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Package/Package.hpp"
+
+enum class DurationKind { FIXED, EXPONENTIAL, UNIFORM, EMPIRICAL, LOGNORMAL };
+
+class DurationDistribution {
+public:
+    DurationDistribution(TimeOffset value = 1); //stały czas (niejawna konwersja z liczby tur)
+
+    static DurationDistribution exponential(double mean);
+    static DurationDistribution uniform(TimeOffset low, TimeOffset high); //włącznie
+    static DurationDistribution empirical(std::vector<TimeOffset> values, std::vector<double> weights);
+    static DurationDistribution lognormal(double mu, double sigma); //parametry ln X
+
+    DurationKind get_kind() const;
+    bool is_fixed() const;
+
+    //parametry: EXPONENTIAL (średnia), UNIFORM (low, high), LOGNORMAL (mu, sigma)
+    double get_first() const;
+    double get_second() const;
+    const std::vector<TimeOffset>& get_values() const;  //EMPIRICAL
+    const std::vector<double>& get_weights() const;
+
+    //średnia liczba tur (LOGNORMAL: przybliżenie ciągłe + 1/2)
+    double mean() const;
+
+    //wartość stała albo zaokrąglona średnia (co najmniej 1)
+    TimeOffset nominal() const;
+
+    //wartość na pozycji n (>= 1) strumienia seed
+    TimeOffset sample(std::uint64_t seed, std::uint64_t n) const;
+
+    //out[k] = sample(seed, first + k), k < count
+    void sample_block(std::uint64_t seed, std::uint64_t first, std::size_t count, TimeOffset* out) const;
+
+private:
+    DurationKind kind_ = DurationKind::FIXED;
+    double a_ = 1.0;
+    double b_ = 0.0;
+    std::vector<TimeOffset> values_;
+    std::vector<double> weights_;
+
+    //EMPIRICAL: tablica aliasów (Walker) -> losowanie O(1) z jednej liczby
+    std::vector<double> threshold_;
+    std::vector<std::uint32_t> alias_;
+};
+
+class DurationStream {
+public:
+    DurationStream(TimeOffset value = 1); //stały czas
+    DurationStream(DurationDistribution distribution, std::uint64_t seed, std::uint64_t position = 0);
+
+    TimeOffset next(); //kolejny czas, przesuwa pozycję o 1 (rozkład stały: bez zmian)
+
+    const DurationDistribution& get_distribution() const;
+    std::uint64_t get_seed() const;
+    std::uint64_t get_position() const; //ile czasów już pobrano
+    void set_position(std::uint64_t position);
+
+private:
+    static constexpr std::size_t BLOCK = 64;
+
+    DurationDistribution distribution_;
+    std::uint64_t seed_ = 0;
+    std::uint64_t position_ = 0;
+
+    //wartości pozycji block_first_ + 1 .. block_first_ + block_size_
+    std::array<TimeOffset, BLOCK> block_{};
+    std::uint64_t block_first_ = 0;
+    std::size_t block_size_ = 0;
+};
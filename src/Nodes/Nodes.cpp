@@ -1,11 +1,61 @@
 #include "Nodes.hpp"
 
+#include <algorithm>
+#include <stdexcept>
+
+// =======================================================
+// ActiveSet
+// =======================================================
+
+void ActiveSet::reset(std::size_t n) {
+    members_.clear();
+    flags_.assign(n, 0);
+}
+
+void ActiveSet::insert(std::size_t i) {
+    if (!flags_[i]) {
+        flags_[i] = 1;
+        members_.push_back(i);
+    }
+}
+
+bool ActiveSet::contains(std::size_t i) const {
+    return flags_[i] != 0;
+}
+
+bool ActiveSet::empty() const {
+    return members_.empty();
+}
+
+const std::vector<std::size_t>& ActiveSet::members() const {
+    return members_;
+}
+
+void ActiveSet::drain_sorted(std::vector<std::size_t>& out) {
+    std::sort(members_.begin(), members_.end());
+    out.swap(members_);
+    members_.clear();
+    for (std::size_t i : out) {
+        flags_[i] = 0;
+    }
+}
+
 // =======================================================
 // ReceiverPreferences
 // =======================================================
 
+bool ReceiverOrder::operator()(
+    const IPackageReceiver* a,
+    const IPackageReceiver* b
+) const {
+    if (a->get_receiver_type() != b->get_receiver_type()) {
+        return a->get_receiver_type() < b->get_receiver_type();
+    }
+    return a->get_id() < b->get_id();
+}
+
 ReceiverPreferences::ReceiverPreferences(ProbabilityGenerator pg)
-    : probability_generator_(pg ? pg : [](){ return 0.5; }) {}
+    : probability_generator_(pg ? pg : FixedProbability{0.5}) {}
 
 void ReceiverPreferences::normalize() {
     if (preferences_.empty()) return;
@@ -43,6 +93,18 @@ IPackageReceiver* ReceiverPreferences::choose_receiver() {
     return nullptr;
 }
 
+double ReceiverPreferences::draw() {
+    return probability_generator_();
+}
+
+ProbabilityGenerator& ReceiverPreferences::get_probability_generator() {
+    return probability_generator_;
+}
+
+const ProbabilityGenerator& ReceiverPreferences::get_probability_generator() const {
+    return probability_generator_;
+}
+
 const ReceiverPreferences::preferences_t&
 ReceiverPreferences::get_preferences() const {
     return preferences_;
@@ -78,6 +140,15 @@ PackageSender::PackageSender()
 void PackageSender::push_package(Package&& package) {
     sending_package_ = std::move(package);
     has_sending_package_ = true;
+
+    if (sender_set_) {
+        sender_set_->insert(sender_index_);
+    }
+}
+
+void PackageSender::attach_sender_set(ActiveSet* set, std::size_t index) {
+    sender_set_ = set;
+    sender_index_ = index;
 }
 
 void PackageSender::send_package() {
@@ -86,12 +157,54 @@ void PackageSender::send_package() {
     IPackageReceiver* receiver =
         receiver_preferences.choose_receiver();
 
+    // odmowa -> liczona u odbiorcy (ograniczoną kolejkę ma tylko robotnik)
+    auto accepts = [](IPackageReceiver* r) {
+        if (r->can_receive()) return true;
+        if (r->get_receiver_type() == ReceiverType::WORKER) {
+            static_cast<Worker*>(r)->record_rejection();
+        }
+        return false;
+    };
+
+    // pełna kolejka -> kolejni odbiorcy w porządku preferencji
+    if (receiver && !accepts(receiver)) {
+        const auto& prefs = receiver_preferences.get_preferences();
+        auto it = prefs.find(receiver);
+        receiver = nullptr;
+        for (std::size_t n = 1; n < prefs.size(); ++n) {
+            if (++it == prefs.end()) it = prefs.begin();
+            if (accepts(it->first)) {
+                receiver = it->first;
+                break;
+            }
+        }
+    }
+
     if (receiver) {
         receiver->receive_package(std::move(sending_package_));
         has_sending_package_ = false;
+    } else {
+        ++blocked_turns_;
     }
 }
 
+long long PackageSender::get_blocked_turns() const {
+    return blocked_turns_;
+}
+
+void PackageSender::record_blocked_turn() {
+    ++blocked_turns_;
+}
+
+void PackageSender::restore_blocked_turns(long long turns) {
+    blocked_turns_ = turns;
+}
+
+Package PackageSender::take_package() {
+    has_sending_package_ = false;
+    return std::move(sending_package_);
+}
+
 bool PackageSender::has_package() const {
     return has_sending_package_;
 }
@@ -104,12 +217,107 @@ const Package& PackageSender::get_package() const {
 // Ramp
 // =======================================================
 
-Ramp::Ramp(ElementID id, TimeOffset delivery_interval)
-    : id_(id), delivery_interval_(delivery_interval) {}
+Ramp::Ramp(ElementID id, DurationStream delivery_interval, int priority, TimeOffset deadline)
+    : id_(id), delivery_interval_(std::move(delivery_interval)), priority_(priority), deadline_(deadline) {}
+
+Ramp::Ramp(ElementID id, TraceReader trace, int priority, TimeOffset deadline)
+    : id_(id),
+      priority_(priority),
+      deadline_(deadline),
+      trace_(std::make_unique<TraceReader>(std::move(trace))) {}
+
+Package Ramp::make_package(Time t) const {
+    Package package;
+    package.set_priority(priority_);
+    if (deadline_ > 0) {
+        package.set_deadline(t + deadline_);
+    }
+    return package;
+}
 
 void Ramp::deliver_goods(Time t) {
-    if ((t - 1) % delivery_interval_ == 0) {
-        push_package(Package());
+    if (trace_) {
+        deliver_trace(t);
+        return;
+    }
+    if (delivery_interval_.get_distribution().is_fixed()) {
+        if ((t - 1) % get_delivery_interval() != 0) return;
+    } else {
+        if (t < next_delivery_) return;
+        next_delivery_ = t + delivery_interval_.next();
+    }
+
+    if (has_sending_package_) {
+        ++lost_deliveries_;
+        return;
+    }
+    push_package(make_package(t));
+}
+
+// Dostawy z zapisu do tury t -> paczki czekające na rampie;
+// najstarsza paczka do wolnego bufora
+void Ramp::deliver_trace(Time t) {
+    for (const TraceRecord* r; (r = trace_->peek()) && r->turn <= t; trace_->pop()) {
+        if (r->count > 0) {
+            pending_.push_back(*r);
+            backlog_ += r->count;
+        }
+    }
+
+    if (has_sending_package_ || pending_.empty()) return;
+
+    push_package(make_package(pending_.front().turn));
+    --backlog_;
+    if (--pending_.front().count == 0) {
+        pending_.pop_front();
+    }
+}
+
+Time Ramp::next_delivery_time(Time t) const {
+    if (trace_) {
+        if (!pending_.empty()) return t;
+        const TraceRecord* r = trace_->peek();
+        return r ? std::max(r->turn, t) : NO_DELIVERY;
+    }
+    if (!delivery_interval_.get_distribution().is_fixed()) {
+        return std::max(next_delivery_, t);
+    }
+    const TimeOffset interval = get_delivery_interval();
+    Time r = (t - 1) % interval;
+    if (r < 0) r += interval;
+    return (r == 0) ? t : t + (interval - r);
+}
+
+int Ramp::get_priority() const {
+    return priority_;
+}
+
+TimeOffset Ramp::get_deadline() const {
+    return deadline_;
+}
+
+long long Ramp::get_lost_deliveries() const {
+    return lost_deliveries_;
+}
+
+void Ramp::restore_lost_deliveries(long long lost) {
+    lost_deliveries_ = lost;
+}
+
+void Ramp::restore_delivery_schedule(Time next_delivery, std::uint64_t position) {
+    next_delivery_ = next_delivery;
+    delivery_interval_.set_position(position);
+}
+
+void Ramp::restore_trace(std::uint64_t offset, std::deque<TraceRecord> pending) {
+    if (!trace_) {
+        throw std::logic_error("Ramp has no delivery trace");
+    }
+    trace_->seek(offset);
+    pending_ = std::move(pending);
+    backlog_ = 0;
+    for (const TraceRecord& r : pending_) {
+        backlog_ += r.count;
     }
 }
 
@@ -118,40 +326,194 @@ ElementID Ramp::get_id() const {
 }
 
 TimeOffset Ramp::get_delivery_interval() const {
+    return delivery_interval_.get_distribution().nominal();
+}
+
+const DurationStream& Ramp::get_delivery_stream() const {
     return delivery_interval_;
 }
 
+bool Ramp::has_fixed_schedule() const {
+    return !trace_ && delivery_interval_.get_distribution().is_fixed();
+}
+
+const TraceReader* Ramp::get_trace() const {
+    return trace_.get();
+}
+
+const std::deque<TraceRecord>& Ramp::get_pending_arrivals() const {
+    return pending_;
+}
+
+std::uint64_t Ramp::get_backlog() const {
+    return backlog_;
+}
+
 // =======================================================
 // Worker
 // =======================================================
 
 Worker::Worker(
     ElementID id,
-    TimeOffset processing_duration,
-    std::unique_ptr<IPackageQueue> queue
+    DurationStream processing_time,
+    std::unique_ptr<IPackageQueue> queue,
+    std::size_t servers,
+    std::size_t batch_size,
+    std::size_t queue_capacity
 )
     : id_(id),
-      processing_duration_(processing_duration),
+      processing_time_(std::move(processing_time)),
+      processing_duration_(processing_time_.get_distribution().nominal()),
+      servers_(servers),
+      batch_size_(batch_size),
+      queue_capacity_(queue_capacity),
       queue_(std::move(queue)),
       is_processing_(false),
-      processing_start_time_(0) {}
+      processing_start_time_(0) {
+    if (servers_ == 0 || batch_size_ == 0) {
+        throw std::invalid_argument("Worker servers and batch size must be positive");
+    }
+}
 
 void Worker::receive_package(Package&& package) {
     queue_->push(std::move(package));
+
+    ++stats_.received;
+    if (clock_) {
+        stats_.arrival_time_sum += *clock_;
+    }
+
+    if (worker_set_) {
+        worker_set_->insert(worker_index_);
+    }
+}
+
+bool Worker::can_receive() const {
+    return queue_capacity_ == 0 || queue_->size() < queue_capacity_;
+}
+
+void Worker::record_rejection() {
+    ++stats_.rejected;
+}
+
+std::size_t Worker::get_queue_capacity() const {
+    return queue_capacity_;
+}
+
+bool Worker::has_work() const {
+    return is_processing_ || !queue_->empty() || !in_flight_.empty() || !finished_.empty();
+}
+
+void Worker::attach_worker_set(ActiveSet* set, std::size_t index) {
+    worker_set_ = set;
+    worker_index_ = index;
+}
+
+void Worker::attach_clock(const Time* clock) {
+    clock_ = clock;
+}
+
+const WorkerStats& Worker::get_stats() const {
+    return stats_;
+}
+
+void Worker::restore_stats(const WorkerStats& stats) {
+    stats_ = stats;
 }
 
 void Worker::do_work(Time t) {
+    if (is_multi_server()) {
+        do_multi_work(t);
+        return;
+    }
+
+    start_processing(t);
+
+    // zajęty bufor (odbiorcy z pełnymi kolejkami) -> paczka czeka w obróbce
+    if (is_processing_ && !has_sending_package_) {
+        if (t - processing_start_time_ + 1 >= processing_duration_) {
+            finish_processing();
+        }
+    }
+}
+
+bool Worker::start_processing(Time t) {
     if (!is_processing_ && !queue_->empty()) {
         processing_package_ = queue_->pop();
         processing_start_time_ = t;
+        processing_duration_ = processing_time_.next();
         is_processing_ = true;
     }
+    return is_processing_;
+}
 
-    if (is_processing_) {
-        if (t - processing_start_time_ + 1 >= processing_duration_) {
-            push_package(std::move(processing_package_));
-            is_processing_ = false;
+void Worker::finish_processing() {
+    push_package(std::move(processing_package_));
+    is_processing_ = false;
+
+    // obróbka trwa processing_duration_ tur (co najmniej jedną)
+    TimeOffset duration = (processing_duration_ > 0) ? processing_duration_ : 1;
+    ++stats_.processed;
+    stats_.busy_turns += duration;
+    stats_.departure_time_sum += processing_start_time_ + duration;
+}
+
+std::size_t Worker::busy_servers() const {
+    // paczki o tym samym starcie: ceil(n / B) stanowisk
+    // (partie pobierane kolejno, niepełna co najwyżej ostatnia);
+    // paczki czekające na wyjście nadal zajmują stanowiska
+    // -> w robotniku najwyżej k * B paczek poza kolejką
+    std::size_t busy = (finished_.size() + batch_size_ - 1) / batch_size_;
+    for (auto it = in_flight_.begin(); it != in_flight_.end();) {
+        auto group = std::find_if(it, in_flight_.end(),
+            [start = it->start](const InFlightPackage& p) { return p.start != start; });
+        const auto n = static_cast<std::size_t>(group - it);
+        busy += (n + batch_size_ - 1) / batch_size_;
+        it = group;
+    }
+    return busy;
+}
+
+void Worker::do_multi_work(Time t) {
+    // start: wolne stanowiska biorą partie po B paczek (jeden czas na partię)
+    for (std::size_t busy = busy_servers(); busy < servers_ && !queue_->empty(); ++busy) {
+        const TimeOffset duration = processing_time_.next();
+        for (std::size_t b = 0; b < batch_size_ && !queue_->empty(); ++b) {
+            in_flight_.push_back(InFlightPackage{queue_->pop(), t, duration});
+        }
+    }
+
+    // koniec: partie kończą się w kolejności startu; sąsiednie paczki
+    // o tym samym starcie i czasie to pełne partie i co najwyżej jedna niepełna
+    // (przy czasie stałym zakończone są zawsze na początku kolejki)
+    for (auto it = in_flight_.begin(); it != in_flight_.end();) {
+        if (t - it->start + 1 < it->duration) {
+            ++it;
+            continue;
         }
+
+        const Time start = it->start;
+        const TimeOffset duration = std::max<TimeOffset>(it->duration, 1);
+        auto group = std::find_if(it, in_flight_.end(),
+            [start, d = it->duration](const InFlightPackage& p) {
+                return p.start != start || p.duration != d;
+            });
+        const auto n = static_cast<std::size_t>(group - it);
+        for (auto p = it; p != group; ++p) {
+            finished_.push_back(std::move(p->package));
+        }
+        it = in_flight_.erase(it, group);
+
+        const auto batches = static_cast<long long>((n + batch_size_ - 1) / batch_size_);
+        stats_.processed += n;
+        stats_.busy_turns += batches * duration;
+        stats_.departure_time_sum += static_cast<long long>(n) * (start + duration);
+    }
+
+    // wyjście: jedna paczka na turę, bez nadpisywania bufora
+    if (!has_sending_package_ && !finished_.empty()) {
+        push_package(std::move(finished_.front()));
+        finished_.pop_front();
     }
 }
 
@@ -167,14 +529,118 @@ TimeOffset Worker::get_processing_duration() const {
     return processing_duration_;
 }
 
+const DurationStream& Worker::get_processing_stream() const {
+    return processing_time_;
+}
+
 Time Worker::get_package_processing_start_time() const {
     return processing_start_time_;
 }
 
+std::size_t Worker::get_servers() const {
+    return servers_;
+}
+
+std::size_t Worker::get_batch_size() const {
+    return batch_size_;
+}
+
+bool Worker::is_multi_server() const {
+    return servers_ > 1 || batch_size_ > 1;
+}
+
 bool Worker::is_processing() const {
     return is_processing_;
 }
 
+const Package& Worker::get_processing_package() const {
+    return processing_package_;
+}
+
+const std::deque<InFlightPackage>& Worker::get_in_flight() const {
+    return in_flight_;
+}
+
+const std::deque<Package>& Worker::get_finished() const {
+    return finished_;
+}
+
+std::size_t Worker::get_in_process_count() const {
+    return (is_processing_ ? 1 : 0) + in_flight_.size() + finished_.size();
+}
+
+Time Worker::next_work_time(Time t) const {
+    if (!is_multi_server()) {
+        if (!is_processing_) {
+            return t + 1; // paczka w kolejce czeka na start
+        }
+        return std::max(processing_start_time_ + processing_duration_ - 1, t + 1);
+    }
+
+    // paczka czeka na wyjście albo na wolne stanowisko
+    if (!finished_.empty() || in_flight_.empty() ||
+        (!queue_->empty() && busy_servers() < servers_)) {
+        return t + 1;
+    }
+    Time next = in_flight_.front().start + in_flight_.front().duration - 1;
+    for (const InFlightPackage& p : in_flight_) {
+        next = std::min(next, p.start + p.duration - 1);
+    }
+    return std::max(next, t + 1);
+}
+
+void Worker::restore_processing(Package&& package, Time start, TimeOffset duration) {
+    processing_package_ = std::move(package);
+    processing_start_time_ = start;
+    processing_duration_ = duration;
+    is_processing_ = true;
+
+    if (worker_set_) {
+        worker_set_->insert(worker_index_);
+    }
+}
+
+void Worker::restore_queued(Package&& package) {
+    queue_->push(std::move(package));
+
+    if (worker_set_) {
+        worker_set_->insert(worker_index_);
+    }
+}
+
+void Worker::restore_in_flight(Package&& package, Time start, TimeOffset duration) {
+    in_flight_.push_back(InFlightPackage{std::move(package), start, duration});
+
+    if (worker_set_) {
+        worker_set_->insert(worker_index_);
+    }
+}
+
+void Worker::restore_finished(Package&& package) {
+    finished_.push_back(std::move(package));
+
+    if (worker_set_) {
+        worker_set_->insert(worker_index_);
+    }
+}
+
+void Worker::restore_processing_position(std::uint64_t position) {
+    processing_time_.set_position(position);
+}
+
+Package Worker::release_processing() {
+    is_processing_ = false;
+    return std::move(processing_package_);
+}
+
+void Worker::clear_processing() {
+    if (is_processing_) {
+        release_processing();
+    }
+    in_flight_.clear();
+    finished_.clear();
+}
+
 IPackageQueue* Worker::get_queue() const {
     return queue_.get();
 }
@@ -206,6 +672,13 @@ Storehouse::Storehouse(
     : id_(id), stockpile_(std::move(stockpile)) {}
 
 void Storehouse::receive_package(Package&& package) {
+    if (package.has_deadline()) {
+        const long long tardiness = std::max<long long>(0, static_cast<long long>(now_) - package.get_deadline());
+        ++deadline_stats_.due;
+        if (tardiness > 0) ++deadline_stats_.late;
+        deadline_stats_.tardiness_sum += tardiness;
+        deadline_stats_.max_tardiness = std::max(deadline_stats_.max_tardiness, tardiness);
+    }
     stockpile_->push(std::move(package));
 }
 
@@ -217,6 +690,29 @@ ReceiverType Storehouse::get_receiver_type() const {
     return ReceiverType::STOREHOUSE;
 }
 
+void Storehouse::set_time(Time t) {
+    now_ = t;
+    stockpile_->set_time(t);
+}
+
+const DeadlineStats& Storehouse::get_deadline_stats() const {
+    return deadline_stats_;
+}
+
+void Storehouse::restore_deadline_stats(const DeadlineStats& stats) {
+    deadline_stats_ = stats;
+}
+
+IPackageStockpile* Storehouse::get_stockpile() const {
+    return stockpile_.get();
+}
+
+StockpileType Storehouse::get_stockpile_type() const {
+    return dynamic_cast<const PackageSummary*>(stockpile_.get())
+        ? StockpileType::SUMMARY
+        : StockpileType::FULL;
+}
+
 Storehouse::const_iterator Storehouse::begin() const {
     return stockpile_->begin();
 }
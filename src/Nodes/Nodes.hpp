@@ -7,18 +7,21 @@
 
 #pragma once
 
+#include <deque>
 #include <map>
 //#include <optional>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <vector>
 // #include <stdexcept>
 // #include <list>
 
-#include "package/Package.hpp"
-
-//Alias typu czasu symulacji
-using Time = int;
-using TimeOffset = int;
+#include "Package/Package.hpp"
+#include "Package/PackageStorage.hpp"
+#include "Nodes/RandomStream.hpp"
+#include "Nodes/Duration.hpp"
+#include "Nodes/Trace.hpp"
 
 //Alias generatora liczb losowych
 using ProbabilityGenerator = std::function<double()>;
@@ -41,6 +44,17 @@ public:
 
     virtual ElementID get_id() const = 0;
     virtual ReceiverType get_receiver_type() const = 0;
+
+    // Czy odbiorca przyjmie teraz paczkę (ograniczona pojemność).
+    // false -> nadawca liczy odmowę u odbiorcy (Worker::record_rejection)
+    // i próbuje innych odbiorców albo zatrzymuje paczkę w buforze.
+    virtual bool can_receive() const { return true; }
+};
+
+// Porządek odbiorców w preferencjach: rodzaj, potem ID
+// (niezależny od adresów w pamięci -> ten sam wybór odbiorcy w każdym przebiegu)
+struct ReceiverOrder {
+    bool operator()(const IPackageReceiver* a, const IPackageReceiver* b) const;
 };
 
 
@@ -48,7 +62,7 @@ public:
 // Receiver preferences
 class ReceiverPreferences {
 public:
-    using preferences_t = std::map<IPackageReceiver*, double>;
+    using preferences_t = std::pmr::map<IPackageReceiver*, double, ReceiverOrder>;
     using const_iterator = preferences_t::const_iterator;
 
     explicit ReceiverPreferences(
@@ -60,6 +74,13 @@ public:
 
     IPackageReceiver* choose_receiver();
 
+    // losuje liczbę z generatora (jak choose_receiver, bez wyboru odbiorcy)
+    double draw();
+
+    // generator (np. RandomStream -> zapis/odtworzenie pozycji strumienia)
+    ProbabilityGenerator& get_probability_generator();
+    const ProbabilityGenerator& get_probability_generator() const;
+
     const preferences_t& get_preferences() const;
 
     const_iterator begin() const;
@@ -76,6 +97,45 @@ private:
     ProbabilityGenerator probability_generator_;
 };
 
+// Zbiór aktywnych węzłów (gęste indeksy nadane przez Factory)
+// Węzły same zgłaszają się przy zmianie stanu (paczka w buforze / w kolejce),
+// więc fabryka iteruje tylko po tych, które mogą coś zrobić.
+class ActiveSet {
+public:
+    void reset(std::size_t n);   // czyści zbiór i ustala liczbę węzłów
+    void insert(std::size_t i);  // bez duplikatów
+    bool contains(std::size_t i) const;
+    bool empty() const;
+    const std::vector<std::size_t>& members() const; // bez porządku
+
+    // przenosi członków do out (rosnąco) i czyści zbiór
+    void drain_sorted(std::vector<std::size_t>& out);
+
+private:
+    std::vector<std::size_t> members_;
+    std::vector<char> flags_;
+};
+
+// Liczniki pracy robotnika (analiza wąskich gardeł)
+// Czas pobytu paczek liczony z sum czasów przybycia i odejścia:
+// pobyt = sum(odejście) - sum(przybycie) (+ paczki obecne do końca przebiegu)
+struct WorkerStats {
+    std::size_t received = 0;          // paczki przyjęte do kolejki
+    std::size_t rejected = 0;          // odmowy przyjęcia (pełna kolejka)
+    std::size_t processed = 0;         // zakończone obróbki
+    long long busy_turns = 0;          // tury zakończonych obróbek
+    long long arrival_time_sum = 0;    // suma tur przybycia
+    long long departure_time_sum = 0;  // suma (tura końca obróbki + 1)
+};
+
+// Terminy paczek przyjętych przez magazyn (paczki z deadline)
+struct DeadlineStats {
+    std::size_t due = 0;               // paczki z terminem
+    std::size_t late = 0;              // przyjęte po terminie
+    long long tardiness_sum = 0;       // suma max(0, tura przyjęcia - termin)
+    long long max_tardiness = 0;
+};
+
 // Sender base
 class PackageSender {
 public:
@@ -83,6 +143,7 @@ public:
 
     PackageSender();
     PackageSender(PackageSender&&) = default;
+    PackageSender& operator=(PackageSender&&) = default;
 
     PackageSender(const PackageSender&) = delete;
     PackageSender& operator=(const PackageSender&) = delete;
@@ -92,36 +153,138 @@ public:
     void push_package(Package&& p);
     void send_package();
 
+    // zabiera paczkę z bufora (bufor musi być zajęty)
+    Package take_package();
+
     bool has_package() const;
     const Package& get_package() const;
 
+    // zgłaszanie zajętego bufora do zbioru aktywnych nadawców fabryki
+    void attach_sender_set(ActiveSet* set, std::size_t index);
+
+    // tury, w których paczka została w buforze (brak odbiorcy)
+    long long get_blocked_turns() const;
+
+    // nieudane wysłanie poza send_package (np. FactorySnapshot::send)
+    void record_blocked_turn();
+
+    // odtworzenie licznika blokad (checkpoint)
+    void restore_blocked_turns(long long turns);
+
 protected:
     bool has_sending_package_;
     Package sending_package_;
+    long long blocked_turns_ = 0;
+
+private:
+    ActiveSet* sender_set_ = nullptr;
+    std::size_t sender_index_ = 0;
 };
 
 // LoadingRamp
+//
+// priority -> priorytet paczek rampy, deadline -> termin paczki
+// dostarczonej w turze t to t + deadline (0 -> bez terminu)
+// Stały odstęp di: dostawy w turach t, dla których (t - 1) % di == 0.
+// Odstęp losowy: pierwsza dostawa w turze 1, kolejna po odstępie
+// pobranym ze strumienia rampy.
+// Zapis dostaw (trace): dostawy w turach z pliku, czytanego na bieżąco.
+// Paczki dostawy czekają na rampie i wychodzą po jednej na turę
+// (bufor nadawcy), więc nie przepadają; termin liczony od tury dostawy.
 class Ramp : public PackageSender {
 public:
-    Ramp(ElementID id, TimeOffset delivery_interval);
+    // brak kolejnych dostaw (koniec zapisu)
+    static constexpr Time NO_DELIVERY = std::numeric_limits<Time>::max();
+
+    Ramp(ElementID id, DurationStream delivery_interval,
+         int priority = 0, TimeOffset deadline = 0);
+    Ramp(ElementID id, TraceReader trace,
+         int priority = 0, TimeOffset deadline = 0);
 
     ElementID get_id() const;
+
+    // stały odstęp albo zaokrąglona średnia rozkładu (trace: bez znaczenia)
     TimeOffset get_delivery_interval() const;
+    const DurationStream& get_delivery_stream() const;
+
+    // stały odstęp dostaw (bez losowania i bez zapisu dostaw)
+    bool has_fixed_schedule() const;
+
+    // najbliższa tura dostawy >= t (albo NO_DELIVERY)
+    Time next_delivery_time(Time t) const;
+
+    // zapis dostaw (nullptr -> rampa bez zapisu)
+    const TraceReader* get_trace() const;
 
+    // paczki z zapisu czekające na wyjście (tura dostawy, liczba)
+    const std::deque<TraceRecord>& get_pending_arrivals() const;
+    std::uint64_t get_backlog() const;
+
+    int get_priority() const;
+    TimeOffset get_deadline() const;
+
+    // paczka dostawy w turze t (ID z rejestru, atrybuty rampy)
+    Package make_package(Time t) const;
+
+    // dostawa przy zajętym buforze (paczka poprzedniej dostawy
+    // zablokowana przez pełne kolejki odbiorców) przepada
     void deliver_goods(Time t);
 
+    long long get_lost_deliveries() const;
+
+    // odtworzenie licznika (checkpoint)
+    void restore_lost_deliveries(long long lost);
+
+    // odtworzenie harmonogramu odstępów losowych (checkpoint)
+    void restore_delivery_schedule(Time next_delivery, std::uint64_t position);
+
+    // odtworzenie pozycji w zapisie dostaw (checkpoint)
+    void restore_trace(std::uint64_t offset, std::deque<TraceRecord> pending);
+
 private:
     ElementID id_;
-    TimeOffset delivery_interval_;
+    DurationStream delivery_interval_;
+    Time next_delivery_ = 1;   // tylko odstęp losowy
+    int priority_;
+    TimeOffset deadline_;
+    long long lost_deliveries_ = 0;
+
+    std::unique_ptr<TraceReader> trace_;
+    std::deque<TraceRecord> pending_;
+    std::uint64_t backlog_ = 0;   // suma liczb w pending_
+
+    void deliver_trace(Time t);
+};
+
+// Paczka w obróbce robotnika wielostanowiskowego
+struct InFlightPackage {
+    Package package;
+    Time start;
+    TimeOffset duration;   // czas obróbki partii
 };
 
 // Worker
-class Worker : public PackageSender, public IPackageReceiver {
+//
+// servers (k) -> do k obróbek naraz ze wspólnej kolejki
+// batch (B)   -> jedna obróbka obejmuje do B paczek z kolejki
+// Przy k = B = 1 klasyczny robotnik (jedna paczka w obróbce).
+// W trybie k > 1 lub B > 1 paczki po obróbce czekają na wyjście:
+// bufor nadawcy przyjmuje jedną paczkę na turę, a czekające paczki
+// zajmują stanowiska (ceil(n / B)).
+// queue_capacity > 0 -> kolejka ograniczona (can_receive() == false przy
+// pełnej kolejce); zakończona paczka czeka w obróbce, dopóki bufor nadawcy
+// jest zajęty.
+// Czas obróbki losowy -> każda obróbka (paczka albo partia) pobiera
+// kolejny czas ze strumienia robotnika w chwili startu.
+class Worker final : public PackageSender, public IPackageReceiver {
 public:
     Worker(
         ElementID id,
-        TimeOffset processing_duration,
-        std::unique_ptr<IPackageQueue> queue
+        DurationStream processing_time,
+        std::unique_ptr<IPackageQueue> queue,
+        std::size_t servers = 1,
+        std::size_t batch_size = 1,
+        std::size_t queue_capacity = 0
     );
 
     Worker(const Worker&) = delete;
@@ -134,17 +297,81 @@ public:
     void receive_package(Package&& p) override;
     ElementID get_id() const override;
     ReceiverType get_receiver_type() const override;
+    bool can_receive() const override;
+    // nadawca zrezygnował z tego robotnika (pełna kolejka)
+    void record_rejection();
+
+    // 0 -> bez limitu
+    std::size_t get_queue_capacity() const;
 
     // work
     void do_work(Time t);
 
+    // etapy do_work (używane też przez układ SoA)
+    bool start_processing(Time t);   // pobiera paczkę z kolejki, jeśli wolny
+    void finish_processing();        // przekazuje paczkę do bufora nadawcy
+
+    // czas bieżącej obróbki (k = B = 1); czas stały -> zawsze ta wartość
     TimeOffset get_processing_duration() const;
+    const DurationStream& get_processing_stream() const;
     Time get_package_processing_start_time() const;
 
+    std::size_t get_servers() const;
+    std::size_t get_batch_size() const;
+
+    // k > 1 lub B > 1: stan w get_in_flight() / get_finished(),
+    // is_processing() zawsze false
+    bool is_multi_server() const;
+
     bool is_processing() const;
+    const Package& get_processing_package() const;
+
+    // paczki w obróbce (rosnąco wg startu) i czekające na wyjście
+    const std::deque<InFlightPackage>& get_in_flight() const;
+    const std::deque<Package>& get_finished() const;
+
+    // wszystkie paczki w robotniku poza kolejką i buforem nadawcy
+    std::size_t get_in_process_count() const;
+
+    // najbliższa tura > t, w której do_work zmieni stan (gdy has_work())
+    Time next_work_time(Time t) const;
+
+    // odtworzenie paczki w obróbce (checkpoint)
+    void restore_processing(Package&& p, Time start, TimeOffset duration);
+
+    // jak wyżej w trybie wielostanowiskowym (kolejne wywołania
+    // w kolejności startu) oraz paczka czekająca na wyjście
+    void restore_in_flight(Package&& p, Time start, TimeOffset duration);
+    void restore_finished(Package&& p);
+
+    // odtworzenie pozycji strumienia czasów obróbki (checkpoint)
+    void restore_processing_position(std::uint64_t position);
+
+    // porzuca wszystkie paczki w obróbce i czekające na wyjście
+    void clear_processing();
+
+    // odtworzenie paczki w kolejce bez zmiany liczników WorkerStats
+    void restore_queued(Package&& p);
+
+    // zabiera paczkę w obróbce bez kończenia pracy (robotnik musi pracować)
+    Package release_processing();
 
     IPackageQueue* get_queue() const;
 
+    // czy robotnik ma coś do zrobienia (paczka w obróbce lub w kolejce)
+    bool has_work() const;
+
+    // zgłaszanie nowej paczki w kolejce do zbioru aktywnych robotników fabryki
+    void attach_worker_set(ActiveSet* set, std::size_t index);
+
+    // zegar fabryki (tura przybycia paczek w receive_package)
+    void attach_clock(const Time* clock);
+
+    const WorkerStats& get_stats() const;
+
+    // odtworzenie liczników (checkpoint)
+    void restore_stats(const WorkerStats& stats);
+
     const_iterator begin() const override;
     const_iterator end() const override;
     const_iterator cbegin() const override;
@@ -154,18 +381,35 @@ public:
 
 
 private:
+    // do_work dla k > 1 lub B > 1
+    void do_multi_work(Time t);
+    std::size_t busy_servers() const;
+
     ElementID id_;
-    TimeOffset processing_duration_;
+    DurationStream processing_time_;
+    TimeOffset processing_duration_;   // bieżąca obróbka
+    std::size_t servers_;
+    std::size_t batch_size_;
+    std::size_t queue_capacity_;
 
     std::unique_ptr<IPackageQueue> queue_;
 
     bool is_processing_;
     Package processing_package_;
     Time processing_start_time_;
+
+    std::deque<InFlightPackage> in_flight_;
+    std::deque<Package> finished_;
+
+    ActiveSet* worker_set_ = nullptr;
+    std::size_t worker_index_ = 0;
+
+    const Time* clock_ = nullptr;
+    WorkerStats stats_;
 };
 
 // Storehouse
-class Storehouse : public IPackageReceiver {
+class Storehouse final : public IPackageReceiver {
 public:
     explicit Storehouse(
         ElementID id,
@@ -184,6 +428,17 @@ public:
     ElementID get_id() const override;
     ReceiverType get_receiver_type() const override;
 
+    // bieżąca tura (czas przyjęcia paczek w trybie SUMMARY i spóźnienia)
+    void set_time(Time t);
+
+    IPackageStockpile* get_stockpile() const;
+    StockpileType get_stockpile_type() const;
+
+    const DeadlineStats& get_deadline_stats() const;
+
+    // odtworzenie liczników (checkpoint)
+    void restore_deadline_stats(const DeadlineStats& stats);
+
     const_iterator begin() const override;
     const_iterator end() const override;
     const_iterator cbegin() const override;
@@ -194,4 +449,6 @@ public:
 private:
     ElementID id_;
     std::unique_ptr<IPackageStockpile> stockpile_;
+    Time now_ = 0;
+    DeadlineStats deadline_stats_;
 };
\ No newline at end of file
@@ -0,0 +1,25 @@
+#include "RandomStream.hpp"
+
+RandomStream::RandomStream(std::uint64_t seed, std::uint64_t position)
+    : seed_(seed), position_(position) {}
+
+double RandomStream::operator()() {
+    ++position_;
+    return value_at(seed_, position_);
+}
+
+std::uint64_t RandomStream::get_seed() const {
+    return seed_;
+}
+
+std::uint64_t RandomStream::get_position() const {
+    return position_;
+}
+
+void RandomStream::set_position(std::uint64_t position) {
+    position_ = position;
+}
+
+std::uint64_t RandomStream::derive_seed(std::uint64_t base, std::uint64_t key) {
+    return mix(base ^ mix(key + 0x9E3779B97F4A7C15ULL));
+}
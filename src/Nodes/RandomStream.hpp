@@ -0,0 +1,54 @@
+// RandomStream -> powtarzalny strumień liczb losowych dla ReceiverPreferences
+// {
+// FixedProbability -> generator stały (domyślny, zawsze 0.5)
+// RandomStream     -> licznikowy splitmix64: wartość n-ta zależy tylko od
+//                     (ziarno, n), więc pozycję strumienia można zapisać,
+//                     odtworzyć i przesunąć bez losowania kolejnych liczb
+// }
+
+#pragma once
+
+#include <cstdint>
+
+//Generator stały
+struct FixedProbability {
+    double value;
+
+    double operator()() const { return value; }
+};
+
+//Strumień liczb z przedziału [0, 1)
+class RandomStream {
+public:
+    explicit RandomStream(std::uint64_t seed = 0, std::uint64_t position = 0);
+
+    double operator()(); //kolejna liczba, przesuwa pozycję o 1
+
+    std::uint64_t get_seed() const;
+    std::uint64_t get_position() const; //ile liczb już pobrano
+    void set_position(std::uint64_t position);
+
+    //wartość na pozycji position (>= 1) strumienia seed, bez stanu
+    //-> kolejne pozycje można liczyć niezależnie (inline -> pętle wektorowe)
+    static double value_at(std::uint64_t seed, std::uint64_t position) {
+        std::uint64_t z = mix(seed + position * 0x9E3779B97F4A7C15ULL);
+
+        //53 najstarsze bity -> double z [0, 1)
+        return static_cast<double>(z >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    //ziarno strumienia pochodnego (np. nadawca o danym ID w danej replikacji)
+    //-> te same (base, key) dają ten sam strumień w każdym wariancie fabryki
+    static std::uint64_t derive_seed(std::uint64_t base, std::uint64_t key);
+
+private:
+    // splitmix64 (Steele, Lea, Flood) -> mieszanie licznika
+    static std::uint64_t mix(std::uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    std::uint64_t seed_;
+    std::uint64_t position_;
+};
@@ -0,0 +1,248 @@
+#include "Trace.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+// =======================================================
+// Funkcje pomocnicze
+// =======================================================
+
+static bool is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Liczba całkowita z [p, end); p za ostatnią cyfrą
+static bool parse_integer(const char*& p, const char* end, bool allow_sign, std::int64_t& out) {
+    bool negative = false;
+    if (allow_sign && p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+    if (p == end || *p < '0' || *p > '9') {
+        return false;
+    }
+
+    std::uint64_t value = 0;
+    const std::uint64_t limit = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+        value = value * 10 + static_cast<std::uint64_t>(*p - '0');
+        if (value > limit) {
+            return false;
+        }
+    }
+    out = negative ? -static_cast<std::int64_t>(value) : static_cast<std::int64_t>(value);
+    return true;
+}
+
+// =======================================================
+// TraceReader
+// =======================================================
+
+TraceReader::TraceReader(TraceSource source)
+    : source_(std::move(source)), buffer_(BUFFER_SIZE) {
+    if (source_.scale <= 0) {
+        throw std::invalid_argument("Trace scale must be positive");
+    }
+    fd_ = ::open(source_.path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        throw std::runtime_error("Cannot open trace file: " + source_.path);
+    }
+
+    // origin z pierwszego rekordu -> tura 1
+    if (!source_.has_origin) {
+        std::int64_t stamp, count;
+        std::uint64_t offset;
+        source_.has_origin = true;
+        source_.origin = read_entry(stamp, count, offset) ? stamp : 0;
+        seek(0);
+    }
+}
+
+TraceReader::~TraceReader() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+TraceReader::TraceReader(TraceReader&& other) noexcept
+    : source_(std::move(other.source_)),
+      fd_(std::exchange(other.fd_, -1)),
+      buffer_(std::move(other.buffer_)),
+      buffer_offset_(other.buffer_offset_),
+      pos_(other.pos_),
+      size_(other.size_),
+      eof_(other.eof_),
+      has_record_(other.has_record_),
+      record_(other.record_),
+      record_offset_(other.record_offset_),
+      has_last_(other.has_last_),
+      last_stamp_(other.last_stamp_) {}
+
+TraceReader& TraceReader::operator=(TraceReader&& other) noexcept {
+    if (this != &other) {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        source_ = std::move(other.source_);
+        fd_ = std::exchange(other.fd_, -1);
+        buffer_ = std::move(other.buffer_);
+        buffer_offset_ = other.buffer_offset_;
+        pos_ = other.pos_;
+        size_ = other.size_;
+        eof_ = other.eof_;
+        has_record_ = other.has_record_;
+        record_ = other.record_;
+        record_offset_ = other.record_offset_;
+        has_last_ = other.has_last_;
+        last_stamp_ = other.last_stamp_;
+    }
+    return *this;
+}
+
+const TraceSource& TraceReader::get_source() const {
+    return source_;
+}
+
+const TraceRecord* TraceReader::peek() {
+    if (!has_record_ && !read_record()) {
+        return nullptr;
+    }
+    return &record_;
+}
+
+void TraceReader::pop() {
+    has_record_ = false;
+}
+
+std::uint64_t TraceReader::get_offset() const {
+    return has_record_ ? record_offset_ : buffer_offset_ + pos_;
+}
+
+void TraceReader::seek(std::uint64_t offset) {
+    buffer_offset_ = offset;
+    pos_ = 0;
+    size_ = 0;
+    eof_ = false;
+    has_record_ = false;
+    has_last_ = false;
+}
+
+// Następna linia [begin, end) w buforze; false -> koniec pliku.
+// pread nie korzysta ze wspólnej pozycji deskryptora, więc kopie
+// czytnika po fork() (simulate_partitioned) czytają niezależnie.
+bool TraceReader::next_line(std::size_t& begin, std::size_t& end) {
+    for (;;) {
+        const void* nl = std::memchr(buffer_.data() + pos_, '\n', size_ - pos_);
+        if (nl) {
+            begin = pos_;
+            end = static_cast<std::size_t>(static_cast<const char*>(nl) - buffer_.data());
+            pos_ = end + 1;
+            return true;
+        }
+        if (eof_) {
+            if (pos_ == size_) return false;
+            begin = pos_;
+            end = size_;
+            pos_ = size_;
+            return true;
+        }
+
+        // niepełna linia na początek bufora, doczytanie reszty
+        std::memmove(buffer_.data(), buffer_.data() + pos_, size_ - pos_);
+        buffer_offset_ += pos_;
+        size_ -= pos_;
+        pos_ = 0;
+        if (size_ == buffer_.size()) {
+            throw std::runtime_error("Trace line too long");
+        }
+
+        ssize_t n;
+        do {
+            n = ::pread(fd_, buffer_.data() + size_, buffer_.size() - size_,
+                        static_cast<off_t>(buffer_offset_ + size_));
+        } while (n < 0 && errno == EINTR);
+        if (n < 0) {
+            throw std::runtime_error("Cannot read trace file: " + source_.path);
+        }
+        if (n == 0) {
+            eof_ = true;
+        }
+        size_ += static_cast<std::size_t>(n);
+    }
+}
+
+// Następny wpis pliku (znacznik, liczba paczek, bajt początku linii)
+bool TraceReader::read_entry(std::int64_t& stamp, std::int64_t& count, std::uint64_t& offset) {
+    std::size_t begin, end;
+    while (next_line(begin, end)) {
+        const char* p = buffer_.data() + begin;
+        const char* e = buffer_.data() + end;
+        while (p < e && is_blank(*p)) ++p;
+        if (p == e || *p == '#') continue;
+
+        count = 1;
+        if (!parse_integer(p, e, true, stamp)) {
+            throw std::runtime_error("Invalid trace timestamp");
+        }
+        while (p < e && is_blank(*p)) ++p;
+        if (p < e && !parse_integer(p, e, false, count)) {
+            throw std::runtime_error("Invalid trace batch size");
+        }
+        while (p < e && is_blank(*p)) ++p;
+        if (p != e) {
+            throw std::runtime_error("Invalid trace line");
+        }
+
+        if (has_last_ && stamp < last_stamp_) {
+            throw std::runtime_error("Trace timestamps must be non-decreasing");
+        }
+        has_last_ = true;
+        last_stamp_ = stamp;
+        offset = buffer_offset_ + begin;
+        return true;
+    }
+    return false;
+}
+
+bool TraceReader::read_record() {
+    std::int64_t stamp, count;
+    std::uint64_t offset;
+    if (!read_entry(stamp, count, offset)) {
+        return false;
+    }
+    if (stamp < source_.origin) {
+        throw std::runtime_error("Trace timestamp before origin");
+    }
+
+    // różnica bez przepełnienia (stamp >= origin)
+    const std::uint64_t turn = (static_cast<std::uint64_t>(stamp) - static_cast<std::uint64_t>(source_.origin))
+        / static_cast<std::uint64_t>(source_.scale) + 1;
+    if (turn > static_cast<std::uint64_t>(std::numeric_limits<Time>::max() / 2)) {
+        throw std::runtime_error("Trace turn out of range");
+    }
+
+    record_ = TraceRecord{static_cast<Time>(turn), static_cast<std::uint64_t>(count)};
+    record_offset_ = offset;
+    has_record_ = true;
+    return true;
+}
+
+// =======================================================
+// Podsumowanie pliku
+// =======================================================
+
+TraceSummary summarize_trace(const TraceSource& source, Time until) {
+    TraceReader reader(source);
+    TraceSummary summary;
+    for (const TraceRecord* r; (r = reader.peek()) && r->turn <= until; reader.pop()) {
+        summary.arrivals += r->count;
+        summary.last_turn = r->turn;
+    }
+    return summary;
+}
@@ -0,0 +1,90 @@
+// Trace -> zapis rzeczywistych dostaw odtwarzany przez rampę
+// {
+// TraceSource  -> plik i przeliczenie znaczników czasu na tury
+// TraceRecord  -> jedna dostawa: tura i liczba paczek
+// TraceReader  -> odczyt przyrostowy (blokami przez pread), bez wczytywania
+//                 całego pliku; pozycję (bajt następnego rekordu) można
+//                 zapisać i odtworzyć
+// }
+//
+// Format pliku: jedna dostawa na linię
+//   <znacznik czasu> [liczba paczek]
+// Znaczniki całkowite, niemalejące; liczba paczek domyślnie 1.
+// Puste linie i linie zaczynające się od '#' są pomijane.
+// Tura dostawy = (znacznik - origin) / scale + 1, origin domyślnie
+// znacznik pierwszego rekordu pliku.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Package/Package.hpp"
+
+struct TraceSource {
+    std::string path;
+    std::int64_t scale = 1;       // jednostek znacznika na turę
+    bool has_origin = false;      // origin podany (inaczej pierwszy rekord)
+    std::int64_t origin = 0;
+};
+
+struct TraceRecord {
+    Time turn;
+    std::uint64_t count;
+};
+
+class TraceReader {
+public:
+    explicit TraceReader(TraceSource source);
+    ~TraceReader();
+
+    TraceReader(const TraceReader&) = delete;
+    TraceReader& operator=(const TraceReader&) = delete;
+    TraceReader(TraceReader&& other) noexcept;
+    TraceReader& operator=(TraceReader&& other) noexcept;
+
+    // źródło (origin uzupełniony z pierwszego rekordu)
+    const TraceSource& get_source() const;
+
+    // następny rekord bez pobierania (nullptr -> koniec pliku)
+    const TraceRecord* peek();
+    void pop();
+
+    // bajt początku następnego niepobranego rekordu (checkpoint)
+    std::uint64_t get_offset() const;
+    void seek(std::uint64_t offset);
+
+private:
+    static constexpr std::size_t BUFFER_SIZE = 1 << 16;
+
+    bool next_line(std::size_t& begin, std::size_t& end);
+    bool read_entry(std::int64_t& stamp, std::int64_t& count, std::uint64_t& offset);
+    bool read_record();
+
+    TraceSource source_;
+    int fd_ = -1;
+
+    // bufor: bajty pliku buffer_offset_ .. buffer_offset_ + size_
+    std::vector<char> buffer_;
+    std::uint64_t buffer_offset_ = 0;
+    std::size_t pos_ = 0;
+    std::size_t size_ = 0;
+    bool eof_ = false;
+
+    bool has_record_ = false;
+    TraceRecord record_{0, 0};
+    std::uint64_t record_offset_ = 0;
+
+    bool has_last_ = false;        // kontrola kolejności znaczników
+    std::int64_t last_stamp_ = 0;
+};
+
+// Dostawy z pliku do tury until włącznie (analiza bez symulacji)
+struct TraceSummary {
+    std::uint64_t arrivals = 0;
+    Time last_turn = 0;
+};
+
+TraceSummary summarize_trace(const TraceSource& source, Time until);
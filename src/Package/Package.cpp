@@ -1,38 +1,156 @@
 #include "Package.hpp"
+#include <algorithm>
 #include <stdexcept>
+#include <new>
 
 //Inicjalizacja statycznych członków klasy Package
-std::set<ElementID> Package::assigned_ids_; //assigned - przypisane
-std::set<ElementID> Package::freed_ids_; //freed - zwolnione
+thread_local std::pmr::set<ElementID> Package::assigned_ids_; //assigned - przypisane
+thread_local std::pmr::set<ElementID> Package::freed_ids_; //freed - zwolnione
+thread_local ElementID Package::assigned_prefix_ = 1;
+
+//Przenosi zbiór do innego zasobu pamięci
+//(przypisanie kontenera pmr nie zmienia jego alokatora, więc budujemy go od nowa)
+static void rebind_registry(std::pmr::set<ElementID>& ids, std::pmr::memory_resource* mr) {
+    using id_set = std::pmr::set<ElementID>;
+    id_set moved(ids.begin(), ids.end(), mr);
+    ids.~id_set();
+    new (&ids) id_set(std::move(moved));
+}
+
+void Package::set_registry_resource(std::pmr::memory_resource* mr) {
+    rebind_registry(assigned_ids_, mr);
+    rebind_registry(freed_ids_, mr);
+}
+
+//ID 1 .. assigned_prefix_ - 1 są przypisane bez wpisów w zbiorze; zbiór
+//trzyma tylko ID spoza ciągłego zakresu -> kolejne nowe paczki (max + 1)
+//przesuwają licznik, a rejestr ma stały rozmiar
+void Package::mark_assigned(ElementID id) {
+    if (id >= 1 && id < assigned_prefix_) return;
+    if (id != assigned_prefix_) {
+        assigned_ids_.insert(id);
+        return;
+    }
+    ++assigned_prefix_;
+    while (!assigned_ids_.empty() && *assigned_ids_.begin() == assigned_prefix_) {
+        assigned_ids_.erase(assigned_ids_.begin());
+        ++assigned_prefix_;
+    }
+}
+
+bool Package::is_assigned(ElementID id) {
+    if (id >= 1 && id < assigned_prefix_) {
+        return freed_ids_.find(id) == freed_ids_.end();
+    }
+    return assigned_ids_.find(id) != assigned_ids_.end();
+}
+
+//max + 1 po wszystkich przypisanych ID
+ElementID Package::next_new_id() {
+    if (assigned_ids_.empty()) return assigned_prefix_;
+    return std::max(assigned_prefix_, *assigned_ids_.rbegin() + 1);
+}
 
 ElementID Package::generate_id() {
     if (!freed_ids_.empty()) {
         //Jeśli są zwolnione ID, użyj jednego z nich
         ElementID id = *freed_ids_.begin();
         freed_ids_.erase(freed_ids_.begin());
-        assigned_ids_.insert(id);
+        mark_assigned(id);
         return id;
     } 
 
     //W przeciwnym razie wygeneruj nowe ID na zasadzie max + 1
-    ElementID new_id = assigned_ids_.empty() ? 1 : (*assigned_ids_.rbegin() + 1);
-    assigned_ids_.insert(new_id);
+    ElementID new_id = next_new_id();
+    mark_assigned(new_id);
     return new_id;
 }
 
+void Package::save_registry(std::vector<ElementID>& assigned, std::vector<ElementID>& freed, ElementID& prefix) {
+    assigned.assign(assigned_ids_.begin(), assigned_ids_.end());
+    freed.assign(freed_ids_.begin(), freed_ids_.end());
+    prefix = assigned_prefix_;
+}
+
+void Package::load_registry(const std::vector<ElementID>& assigned, const std::vector<ElementID>& freed, ElementID prefix) {
+    assigned_ids_.clear();
+    freed_ids_.clear();
+    assigned_prefix_ = std::max(prefix, 1);
+
+    //zwolnione ID nie przerywają ciągłego zakresu (is_assigned je wyklucza)
+    std::vector<ElementID> ids(assigned);
+    ids.insert(ids.end(), freed.begin(), freed.end());
+    std::sort(ids.begin(), ids.end());
+    for (ElementID id : ids) {
+        mark_assigned(id);
+    }
+    freed_ids_.insert(freed.begin(), freed.end());
+}
+
+ElementID Package::next_id() {
+    if (!freed_ids_.empty()) {
+        return *freed_ids_.begin();
+    }
+    return next_new_id();
+}
+
+void Package::skip_ids(ElementID count) {
+    if (count <= 0) return;
+    if (!freed_ids_.empty()) {
+        throw std::logic_error("Cannot skip IDs while freed IDs are pending");
+    }
+    //max + 1 -> kolejne ID zaczną się za pominiętym zakresem
+    const ElementID last = next_id() + count - 1;
+    if (assigned_ids_.empty()) {
+        assigned_prefix_ = last + 1;
+    } else {
+        assigned_ids_.insert(last);
+    }
+}
+
+void Package::claim_ids(ElementID count) {
+    if (count <= 0) return;
+    if (!freed_ids_.empty()) {
+        throw std::logic_error("Cannot claim IDs while freed IDs are pending");
+    }
+    const ElementID first = next_id();
+    if (assigned_ids_.empty()) {
+        assigned_prefix_ = first + count;
+        return;
+    }
+    for (ElementID id = first; id < first + count; ++id) {
+        assigned_ids_.insert(assigned_ids_.end(), id);
+    }
+}
+
+Package Package::restore(ElementID id) {
+    return Package(id, restore_tag{});
+}
+
+Package Package::restore(ElementID id, int priority, Time deadline) {
+    Package package(id, restore_tag{});
+    package.priority_ = priority;
+    package.deadline_ = deadline;
+    return package;
+}
+
+Package::Package(ElementID id, restore_tag) : id_(id) {}
+
 //losowe ID
 Package::Package() : id_(generate_id()) {}
 
 //wybrane konkretne ID
 Package::Package(ElementID id) : id_(id) {
-    if (assigned_ids_.find(id) != assigned_ids_.end()) {
+    if (is_assigned(id)) {
         throw std::invalid_argument("ID already assigned");
     }
-    assigned_ids_.insert(id);
+    freed_ids_.erase(id);
+    mark_assigned(id);
 }
 
 // konstruktor przenoszący
-Package::Package(Package&& other) noexcept : id_(other.id_) {
+Package::Package(Package&& other) noexcept
+    : id_(other.id_), priority_(other.priority_), deadline_(other.deadline_) {
     other.id_ = -1; //Unieważnij ID w obiekcie źródłowym
 }
 
@@ -41,28 +159,64 @@ Package& Package::operator=(Package&& other) noexcept {
     if (this != &other) {
         //Zwolnij obecne ID, jeśli jest ważne
         id_ = other.id_;
+        priority_ = other.priority_;
+        deadline_ = other.deadline_;
         other.id_ = -1; //Unieważnij ID w obiekcie źródłowym
     }
     return *this;
 }
 
-//destruktor
-Package::~Package() {
-    if (id_ != -1) {
-        assigned_ids_.erase(id_);
-        freed_ids_.insert(id_);
-    }
-}
-
 //getter
 ElementID Package::getID() const {
     return id_;
 }
 
-PackageQueue::PackageQueue(PackageQueueType type) : type_(type) {}
+int Package::get_priority() const {
+    return priority_;
+}
+
+Time Package::get_deadline() const {
+    return deadline_;
+}
+
+bool Package::has_deadline() const {
+    return deadline_ != NO_DEADLINE;
+}
+
+void Package::set_priority(int priority) {
+    priority_ = priority;
+}
+
+void Package::set_deadline(Time deadline) {
+    deadline_ = deadline;
+}
+
+PackageQueue::PackageQueue(PackageQueueType type, std::pmr::memory_resource* mr)
+    : type_(type), container_(mr), heap_(mr) {}
+
+bool PackageQueue::is_heap_type() const {
+    return type_ == PackageQueueType::PRIORITY || type_ == PackageQueueType::EDF;
+}
+
+//kopiec minimalny po (klucz, numer przybycia)
+template <typename Entry>
+static bool later_in_queue(const Entry& a, const Entry& b) {
+    return a.key != b.key ? a.key > b.key : a.seq > b.seq;
+}
+
+void PackageQueue::push_heap_entry(std::pmr::list<Package>::iterator it) {
+    std::int64_t key = (type_ == PackageQueueType::PRIORITY)
+        ? -static_cast<std::int64_t>(it->get_priority())
+        : static_cast<std::int64_t>(it->get_deadline());
+    heap_.push_back(HeapEntry{key, next_seq_++, it});
+    std::push_heap(heap_.begin(), heap_.end(), later_in_queue<HeapEntry>);
+}
 
 void PackageQueue::push(Package&& package) {
     container_.push_back(std::move(package));
+    if (is_heap_type()) {
+        push_heap_entry(std::prev(container_.end()));
+    }
 }
 
 Package PackageQueue::pop() {
@@ -70,6 +224,15 @@ Package PackageQueue::pop() {
         throw std::out_of_range("PackageQueue is empty");
     }
 
+    if (is_heap_type()) {
+        std::pop_heap(heap_.begin(), heap_.end(), later_in_queue<HeapEntry>);
+        auto it = heap_.back().package;
+        heap_.pop_back();
+        Package result = std::move(*it);
+        container_.erase(it);
+        return result;
+    }
+
     Package result = std::move(
         (type_ == PackageQueueType::FIFO) ? container_.front() : container_.back()
     );
@@ -108,4 +271,25 @@ PackageQueue::const_iterator PackageQueue::cend() const {
 
 PackageQueueType PackageQueue::getQueueType() const {
     return type_;
+}
+
+void PackageQueue::set_resource(std::pmr::memory_resource* mr) {
+    using package_list = std::pmr::list<Package>;
+    package_list moved(mr);
+    for (Package& package : container_) {
+        moved.push_back(std::move(package));
+    }
+    container_.~package_list();
+    new (&container_) package_list(std::move(moved));
+
+    //kopiec od nowa (iteratory starej listy są nieważne), kolejność przybycia bez zmian
+    using heap_vector = std::pmr::vector<HeapEntry>;
+    heap_.~heap_vector();
+    new (&heap_) heap_vector(mr);
+    next_seq_ = 0;
+    if (is_heap_type()) {
+        for (auto it = container_.begin(); it != container_.end(); ++it) {
+            push_heap_entry(it);
+        }
+    }
 }
\ No newline at end of file
@@ -2,20 +2,30 @@
 //#Package -> pojedynczy półprodukt, który posiada iD
 //IPackageStockpile -> abstrakcyjny "magazyn na paczki"
 //IPackageQueue -> magazyn z możliwością zdejmowania elementów
-//PackageQueue -> implementacja IPackageQueue (FIFO/LIFO)
+//PackageQueue -> implementacja IPackageQueue (FIFO/LIFO/PRIORITY/EDF)
 
 #pragma once
 
 #include <list>
 #include <set>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <vector>
 
 //Alias zamiast pisać int mamy ElementID
 using ElementID = int;
 
+//Alias typu czasu symulacji
+using Time = int;
+using TimeOffset = int;
+
 enum class PackageQueueType {
     FIFO,
-    LIFO
+    LIFO,
+    PRIORITY, //największy priorytet paczki pierwszy (równe -> FIFO)
+    EDF       //najwcześniejszy termin pierwszy (równe -> FIFO)
 };
 
 
@@ -32,21 +42,59 @@ public:
     Package(const Package&) = delete; //usuń konstruktor kopiujący
     Package& operator=(const Package&) = delete; //usuń operator kopiujący
 
-    ~Package() = default; //domyślny destruktor -> zwalnia ID 
+    ~Package() = default; //domyślny destruktor (ID nie wraca do puli wolnych)
 
     ElementID getID() const; //getter zwraca ID paczki
+
+    //atrybuty nadawane na rampie (kolejki PRIORITY / EDF)
+    static constexpr Time NO_DEADLINE = std::numeric_limits<Time>::max();
+    int get_priority() const; //większy -> wcześniej
+    Time get_deadline() const; //tura terminu lub NO_DEADLINE
+    bool has_deadline() const;
+    void set_priority(int priority);
+    void set_deadline(Time deadline);
+
+    //przenosi rejestr ID bieżącego wątku do podanego zasobu pamięci (np. areny symulacji)
+    static void set_registry_resource(std::pmr::memory_resource* mr);
+
+    //stan rejestru ID (checkpoint): ID 1 .. prefix - 1 przypisane (poza zwolnionymi),
+    //assigned -> przypisane ID spoza tego zakresu
+    static void save_registry(std::vector<ElementID>& assigned, std::vector<ElementID>& freed, ElementID& prefix);
+    static void load_registry(const std::vector<ElementID>& assigned, const std::vector<ElementID>& freed, ElementID prefix = 1);
+
+    //paczka o znanym ID, bez rejestracji (ID jest już w odtworzonym rejestrze)
+    static Package restore(ElementID id);
+    static Package restore(ElementID id, int priority, Time deadline);
+
+    //ID, które dostanie następna nowa paczka
+    static ElementID next_id();
+    //pomija count kolejnych ID (przeskok czasu w symulacji okresowej)
+    static void skip_ids(ElementID count);
+    //rejestruje count kolejnych ID (paczki utworzone przez restore() poza rejestrem,
+    //np. w wątkach symulacji optymistycznej)
+    static void claim_ids(ElementID count);
 private:
+    struct restore_tag {};
+    Package(ElementID id, restore_tag); //konstruktor dla restore()
+
     ElementID id_; //ID paczki
+    int priority_ = 0; //priorytet (PRIORITY)
+    Time deadline_ = NO_DEADLINE; //termin (EDF)
 
-    static std::set<ElementID> assigned_ids_; //zbiór przypisanych ID
-    static std::set<ElementID> freed_ids_; //zbiór zwolnionych ID
+    //rejestr osobny dla każdego wątku (równoległe symulacje niezależnych fabryk)
+    static thread_local std::pmr::set<ElementID> assigned_ids_; //zbiór przypisanych ID
+    static thread_local std::pmr::set<ElementID> freed_ids_; //zbiór zwolnionych ID
+    static thread_local ElementID assigned_prefix_; //ID poniżej są przypisane bez wpisów w zbiorze
     static ElementID generate_id(); //generuje unikalne ID
+    static ElementID next_new_id(); //max + 1 po przypisanych ID
+    static void mark_assigned(ElementID id); //dopisuje ID (przesuwa ciągły zakres)
+    static bool is_assigned(ElementID id);
 };
 
 //Klasa IPackageStockpile -> abstrakcyjny magazyn na paczki
 class IPackageStockpile {
 public:
-    using const_iterator = std::list<Package>::const_iterator;
+    using const_iterator = std::pmr::list<Package>::const_iterator;
 
     virtual void push(Package&& package) = 0; //dodaje paczkę do magazynu
     virtual bool empty() const = 0; //sprawdza czy magazyn jest pusty
@@ -57,6 +105,8 @@ public:
     virtual const_iterator cbegin() const = 0; //const iterator na początek
     virtual const_iterator cend() const = 0; //const iterator na koniec
 
+    virtual void set_time(Time) {} //bieżąca tura (dla magazynów liczących czas przyjęcia)
+
     virtual ~IPackageStockpile() = default; //wirtualny destruktor
 };
 
@@ -64,14 +114,20 @@ public:
 class IPackageQueue : public IPackageStockpile {
 public:
     virtual Package pop() = 0; //usuwa i zwraca paczkę z magazynu
-    virtual PackageQueueType getQueueType() const = 0; //zwraca typ kolejki (FIFO/LIFO)
+    virtual PackageQueueType getQueueType() const = 0; //zwraca typ kolejki
     virtual ~IPackageQueue() = default; //wirtualny destruktor
 };
 
-//Klasa PackageQueue -> implementacja IPackageQueue (FIFO/LIFO)
+//Klasa PackageQueue -> implementacja IPackageQueue (FIFO/LIFO/PRIORITY/EDF)
+//PRIORITY/EDF: lista w kolejności przybycia (iteracja) + kopiec
+//iteratorów listy -> push/pop w O(log n)
 class PackageQueue : public IPackageQueue {
 public:
-    explicit PackageQueue(PackageQueueType type); //konstruktor z typem kolejki
+    //konstruktor z typem kolejki; węzły listy z podanego zasobu pamięci
+    explicit PackageQueue(
+        PackageQueueType type,
+        std::pmr::memory_resource* mr = std::pmr::get_default_resource()
+    );
 
     void push(Package&& package) override; //dodaje paczkę do magazynu
     bool empty() const override; //sprawdza czy magazyn jest pusty
@@ -83,10 +139,25 @@ public:
     const_iterator cend() const override; //const iterator na koniec
 
     Package pop() override; //usuwa i zwraca paczkę z magazynu
-    PackageQueueType getQueueType() const override; //zwraca typ kolejki (FIFO/LIFO)
+    PackageQueueType getQueueType() const override; //zwraca typ kolejki
+
+    //przenosi paczki (w tej samej kolejności) do węzłów listy z innego zasobu pamięci
+    void set_resource(std::pmr::memory_resource* mr);
 
     ~PackageQueue() override = default; //domyślny destruktor
 private:
-    PackageQueueType type_; //typ kolejki (FIFO/LIFO)
-    std::list<Package> container_; //lista paczek w magazynie
+    //pozycja kopca: klucz (mniejszy -> wcześniej), numer przybycia, paczka
+    struct HeapEntry {
+        std::int64_t key;
+        std::uint64_t seq;
+        std::pmr::list<Package>::iterator package;
+    };
+
+    bool is_heap_type() const;
+    void push_heap_entry(std::pmr::list<Package>::iterator it);
+
+    PackageQueueType type_; //typ kolejki
+    std::pmr::list<Package> container_; //lista paczek w magazynie (kolejność przybycia)
+    std::pmr::vector<HeapEntry> heap_; //tylko PRIORITY/EDF
+    std::uint64_t next_seq_ = 0;
 };
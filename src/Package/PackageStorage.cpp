@@ -0,0 +1,176 @@
+#include "PackageStorage.hpp"
+
+#include <stdexcept>
+#include <iterator>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+
+PackageSummary::PackageSummary(
+    std::size_t sample_size,
+    TimeOffset bucket_width,
+    std::size_t bucket_count
+)
+    : count_(0),
+      current_time_(1),
+      initial_bucket_width_(bucket_width),
+      bucket_width_(bucket_width),
+      histogram_(bucket_count, 0),
+      sample_size_(sample_size),
+      rng_(5489u) {
+    if (bucket_width <= 0 || bucket_count < 2) {
+        throw std::invalid_argument("Invalid histogram parameters");
+    }
+}
+
+void PackageSummary::push(Package&& package) {
+    //Histogram: tura t trafia do przedziału (t - 1) / w
+    Time t = (current_time_ < 1) ? 1 : current_time_;
+    std::size_t bucket = static_cast<std::size_t>((t - 1) / bucket_width_);
+    while (bucket >= histogram_.size()) {
+        fold_histogram();
+        bucket = static_cast<std::size_t>((t - 1) / bucket_width_);
+    }
+    ++histogram_[bucket];
+    ++count_;
+
+    //Reservoir sampling (algorytm R) -> każda paczka ma szansę k/n
+    if (sample_.size() < sample_size_) {
+        sample_.push_back(std::move(package));
+        sample_slots_.push_back(std::prev(sample_.end()));
+        return;
+    }
+    if (sample_size_ == 0) {
+        return;
+    }
+
+    std::uniform_int_distribution<std::size_t> dist(0, count_ - 1);
+    std::size_t j = dist(rng_);
+    if (j < sample_size_) {
+        *sample_slots_[j] = std::move(package);
+    }
+}
+
+void PackageSummary::add_bulk(std::size_t count, Time from, Time to) {
+    if (count == 0) return;
+    if (from < 1) from = 1;
+    if (to < from) to = from;
+
+    while (static_cast<std::size_t>((to - 1) / bucket_width_) >= histogram_.size()) {
+        fold_histogram();
+    }
+
+    //udział przedziału proporcjonalny do liczby jego tur w [from, to];
+    //zaokrąglane sumy narastające -> błąd każdego przedziału < 1 paczki
+    //i suma udziałów równa count
+    const long double span = static_cast<long double>(to) - from + 1;
+    auto cumulative = [count, span](long double turns) {
+        return static_cast<std::size_t>(std::llround(count * (turns / span)));
+    };
+    std::size_t first = static_cast<std::size_t>((from - 1) / bucket_width_);
+    std::size_t last = static_cast<std::size_t>((to - 1) / bucket_width_);
+
+    for (std::size_t b = first; b <= last; ++b) {
+        long double lo = std::max<long double>(from, static_cast<long double>(b) * bucket_width_ + 1);
+        long double hi = std::min<long double>(to, static_cast<long double>(b + 1) * bucket_width_);
+        histogram_[b] += cumulative(hi - from + 1) - cumulative(lo - from);
+    }
+    count_ += count;
+}
+
+void PackageSummary::fold_histogram() {
+    std::size_t half = histogram_.size() / 2;
+    for (std::size_t i = 0; i < half; ++i) {
+        histogram_[i] = histogram_[2 * i] + histogram_[2 * i + 1];
+    }
+    if (histogram_.size() % 2 != 0) {
+        histogram_[half] = histogram_.back();
+        ++half;
+    }
+    for (std::size_t i = half; i < histogram_.size(); ++i) {
+        histogram_[i] = 0;
+    }
+    bucket_width_ *= 2;
+}
+
+bool PackageSummary::empty() const {
+    return count_ == 0;
+}
+
+std::size_t PackageSummary::size() const {
+    return count_;
+}
+
+PackageSummary::const_iterator PackageSummary::begin() const {
+    return sample_.begin();
+}
+
+PackageSummary::const_iterator PackageSummary::end() const {
+    return sample_.end();
+}
+
+PackageSummary::const_iterator PackageSummary::cbegin() const {
+    return sample_.cbegin();
+}
+
+PackageSummary::const_iterator PackageSummary::cend() const {
+    return sample_.cend();
+}
+
+void PackageSummary::set_time(Time t) {
+    current_time_ = t;
+}
+
+std::size_t PackageSummary::get_sample_size() const {
+    return sample_size_;
+}
+
+TimeOffset PackageSummary::get_initial_bucket_width() const {
+    return initial_bucket_width_;
+}
+
+TimeOffset PackageSummary::get_bucket_width() const {
+    return bucket_width_;
+}
+
+const std::vector<std::size_t>& PackageSummary::get_histogram() const {
+    return histogram_;
+}
+
+Time PackageSummary::get_current_time() const {
+    return current_time_;
+}
+
+std::string PackageSummary::get_rng_state() const {
+    std::ostringstream os;
+    os << rng_;
+    return os.str();
+}
+
+void PackageSummary::restore_state(
+    std::size_t count,
+    Time current_time,
+    TimeOffset bucket_width,
+    const std::vector<std::size_t>& histogram,
+    std::vector<Package>&& sample,
+    const std::string& rng_state
+) {
+    if (histogram.size() != histogram_.size() || bucket_width <= 0) {
+        throw std::invalid_argument("Summary state does not match stockpile");
+    }
+
+    count_ = count;
+    current_time_ = current_time;
+    bucket_width_ = bucket_width;
+    histogram_ = histogram;
+
+    sample_.clear();
+    sample_slots_.clear();
+    for (auto& package : sample) {
+        sample_.push_back(std::move(package));
+        sample_slots_.push_back(std::prev(sample_.end()));
+    }
+
+    std::istringstream is(rng_state);
+    is >> rng_;
+}
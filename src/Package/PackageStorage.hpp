@@ -0,0 +1,89 @@
+//Idea
+//PackageSummary -> magazyn zliczający (tryb podsumowania)
+//Nie przechowuje wszystkich paczek, tylko:
+// - łączną liczbę przyjętych paczek
+// - histogram czasów przyjęcia (stała liczba przedziałów)
+// - opcjonalną próbkę ID (reservoir sampling)
+//Zużycie pamięci nie zależy od długości symulacji.
+
+#pragma once
+
+#include <list>
+#include <vector>
+#include <random>
+#include <string>
+#include <cstddef>
+
+#include "Package.hpp"
+
+//Rodzaj magazynu w Storehouse
+enum class StockpileType {
+    FULL,   //wszystkie paczki (PackageQueue)
+    SUMMARY //tylko podsumowanie (PackageSummary)
+};
+
+//Klasa PackageSummary -> magazyn zliczający
+class PackageSummary : public IPackageStockpile {
+public:
+    //sample_size  -> ile ID zachować w próbce (0 = brak próbki)
+    //bucket_width -> początkowa szerokość przedziału histogramu (w turach)
+    //bucket_count -> stała liczba przedziałów histogramu
+    explicit PackageSummary(
+        std::size_t sample_size = 0,
+        TimeOffset bucket_width = 1,
+        std::size_t bucket_count = 32
+    );
+
+    void push(Package&& package) override; //zlicza paczkę (i ew. dodaje do próbki)
+    bool empty() const override; //czy przyjęto jakąkolwiek paczkę
+    std::size_t size() const override; //łączna liczba przyjętych paczek
+
+    //iteratory przechodzą tylko po próbce
+    const_iterator begin() const override;
+    const_iterator end() const override;
+    const_iterator cbegin() const override;
+    const_iterator cend() const override;
+
+    void set_time(Time t) override; //bieżąca tura -> czas przyjęcia paczek
+
+    //zlicza count paczek przyjętych równomiernie w turach [from, to]
+    //(bez samych paczek; próbka się nie zmienia)
+    void add_bulk(std::size_t count, Time from, Time to);
+
+    std::size_t get_sample_size() const; //pojemność próbki
+    TimeOffset get_initial_bucket_width() const; //szerokość z pliku topologii
+    TimeOffset get_bucket_width() const; //aktualna szerokość przedziału
+    const std::vector<std::size_t>& get_histogram() const; //liczności przedziałów
+
+    //stan wewnętrzny (checkpoint)
+    Time get_current_time() const;
+    std::string get_rng_state() const;
+    void restore_state(
+        std::size_t count,
+        Time current_time,
+        TimeOffset bucket_width,
+        const std::vector<std::size_t>& histogram,
+        std::vector<Package>&& sample,
+        const std::string& rng_state
+    );
+
+    //sample_slots_ wskazuje na węzły własnej listy -> bez kopiowania
+    PackageSummary(const PackageSummary&) = delete;
+    PackageSummary& operator=(const PackageSummary&) = delete;
+
+    ~PackageSummary() override = default;
+private:
+    void fold_histogram(); //scala pary przedziałów i podwaja szerokość
+
+    std::size_t count_; //łączna liczba paczek
+    Time current_time_; //tura, w której przyjmowane są paczki
+
+    TimeOffset initial_bucket_width_;
+    TimeOffset bucket_width_;
+    std::vector<std::size_t> histogram_; //przedział i -> tury [1 + i*w, (i+1)*w]
+
+    std::size_t sample_size_;
+    std::pmr::list<Package> sample_; //próbka paczek (max sample_size_)
+    std::vector<std::pmr::list<Package>::iterator> sample_slots_; //slot próbki -> węzeł listy (podmiana w O(1))
+    std::mt19937 rng_; //stałe ziarno -> powtarzalna próbka
+};
@@ -1,5 +1,7 @@
 #include "Report.hpp"
 
+#include <sstream>
+
 static void print_header(std::ostream& os, const std::string& title) {
     os << "=========================\n"
        << "      " << title << "\n"
@@ -11,7 +13,66 @@ static void print_section(std::ostream& os, const std::string& title) {
 }
 
 static const char* queue_type_to_str(PackageQueueType qt) {
-    return (qt == PackageQueueType::FIFO) ? "FIFO" : "LIFO";
+    switch (qt) {
+        case PackageQueueType::FIFO:     return "FIFO";
+        case PackageQueueType::LIFO:     return "LIFO";
+        case PackageQueueType::PRIORITY: return "PRIORITY";
+        case PackageQueueType::EDF:      return "EDF";
+    }
+    return "FIFO";
+}
+
+// Magazyn w trybie SUMMARY: liczba paczek, próbka ID i niepuste przedziały histogramu
+// Czas stały jako liczba, losowy jako rozkład ze średnią
+static std::string duration_to_str(const DurationStream& stream) {
+    const DurationDistribution& d = stream.get_distribution();
+    std::ostringstream os;
+    switch (d.get_kind()) {
+        case DurationKind::FIXED:
+            return std::to_string(d.nominal());
+        case DurationKind::EXPONENTIAL:
+            os << "exp";
+            break;
+        case DurationKind::UNIFORM:
+            os << "uniform " << d.get_first() << ".." << d.get_second() << ",";
+            break;
+        case DurationKind::EMPIRICAL:
+            os << "empirical " << d.get_values().size() << " values,";
+            break;
+        case DurationKind::LOGNORMAL:
+            os << "lognormal mu " << d.get_first() << " sigma " << d.get_second() << ",";
+            break;
+    }
+    os << " mean " << d.mean();
+    return os.str();
+}
+
+static void print_stockpile_summary(std::ostream& os, const PackageSummary& summary) {
+    os << "      stockpile  : " << summary.size() << " package(s)\n";
+
+    if (summary.get_sample_size() > 0) {
+        os << "      sample     : ";
+        bool empty_s = true;
+        for (auto sit = summary.cbegin(); sit != summary.cend(); ++sit) {
+            empty_s = false;
+            os << sit->getID() << " ";
+        }
+        if (empty_s) os << "(empty)";
+        os << "\n";
+    }
+
+    os << "      arrivals   : ";
+    const auto& hist = summary.get_histogram();
+    TimeOffset w = summary.get_bucket_width();
+    bool empty_h = true;
+    for (std::size_t i = 0; i < hist.size(); ++i) {
+        if (hist[i] == 0) continue;
+        empty_h = false;
+        Time from = static_cast<Time>(i) * w + 1;
+        os << "[" << from << "-" << from + w - 1 << "]:" << hist[i] << " ";
+    }
+    if (empty_h) os << "(none)";
+    os << "\n";
 }
 
 // =======================================================
@@ -29,8 +90,15 @@ void Reports::print_factory_structure(const Factory& factory, std::ostream& os)
     bool any = false;
     for (auto it = factory.ramp_cbegin(); it != factory.ramp_cend(); ++it) {
         any = true;
-        os << "  • Ramp " << it->get_id()
-           << " (delivery every " << it->get_delivery_interval() << ")\n";
+        os << "  • Ramp " << it->get_id();
+        if (it->get_trace()) {
+            os << " (trace " << it->get_trace()->get_source().path;
+        } else {
+            os << " (delivery every " << duration_to_str(it->get_delivery_stream());
+        }
+        if (it->get_priority() != 0) os << ", priority " << it->get_priority();
+        if (it->get_deadline() > 0) os << ", deadline +" << it->get_deadline();
+        os << ")\n";
     }
     if (!any) os << "  (none)\n";
     os << "\n";
@@ -43,9 +111,12 @@ void Reports::print_factory_structure(const Factory& factory, std::ostream& os)
     for (auto it = factory.worker_cbegin(); it != factory.worker_cend(); ++it) {
         any = true;
         os << "  • Worker " << it->get_id()
-           << " | time: " << it->get_processing_duration()
-           << " | queue: " << queue_type_to_str(it->get_queue()->getQueueType())
-           << "\n";
+           << " | time: " << duration_to_str(it->get_processing_stream())
+           << " | queue: " << queue_type_to_str(it->get_queue()->getQueueType());
+        if (it->get_servers() > 1) os << " | servers: " << it->get_servers();
+        if (it->get_queue_capacity() > 0) os << " | capacity: " << it->get_queue_capacity();
+        if (it->get_batch_size() > 1) os << " | batch: " << it->get_batch_size();
+        os << "\n";
     }
     if (!any) os << "  (none)\n";
     os << "\n";
@@ -57,7 +128,11 @@ void Reports::print_factory_structure(const Factory& factory, std::ostream& os)
     any = false;
     for (auto it = factory.storehouse_cbegin(); it != factory.storehouse_cend(); ++it) {
         any = true;
-        os << "  • Storehouse " << it->get_id() << "\n";
+        os << "  • Storehouse " << it->get_id();
+        if (it->get_stockpile_type() == StockpileType::SUMMARY) {
+            os << " | stockpile: SUMMARY";
+        }
+        os << "\n";
     }
     if (!any) os << "  (none)\n";
     os << "\n";
@@ -112,8 +187,15 @@ void Reports::print_simulation_state(const Factory& factory, Time t, std::ostrea
     for (auto it = factory.ramp_cbegin(); it != factory.ramp_cend(); ++it) {
         any = true;
         os << "  • Ramp " << it->get_id()
-           << " | buffer: " << (it->has_package() ? "OCCUPIED" : "EMPTY")
-           << "\n";
+           << " | buffer: " << (it->has_package() ? "OCCUPIED" : "EMPTY");
+        if (it->get_blocked_turns() > 0 || it->get_lost_deliveries() > 0) {
+            os << " | blocked: " << it->get_blocked_turns()
+               << " | lost: " << it->get_lost_deliveries();
+        }
+        if (it->get_backlog() > 0) {
+            os << " | backlog: " << it->get_backlog();
+        }
+        os << "\n";
     }
     if (!any) os << "  (none)\n";
     os << "\n";
@@ -127,7 +209,12 @@ void Reports::print_simulation_state(const Factory& factory, Time t, std::ostrea
         any = true;
 
         os << "  • Worker " << it->get_id() << "\n";
-        os << "      processing : " << (it->is_processing() ? "YES" : "NO") << "\n";
+        if (it->is_multi_server()) {
+            os << "      processing : " << it->get_in_flight().size()
+               << " (waiting for output: " << it->get_finished().size() << ")\n";
+        } else {
+            os << "      processing : " << (it->is_processing() ? "YES" : "NO") << "\n";
+        }
         os << "      queue      : ";
 
         bool empty_q = true;
@@ -137,6 +224,13 @@ void Reports::print_simulation_state(const Factory& factory, Time t, std::ostrea
         }
         if (empty_q) os << "(empty)";
         os << "\n";
+
+        if (it->get_queue_capacity() > 0) {
+            os << "      capacity   : " << it->get_queue()->size()
+               << "/" << it->get_queue_capacity()
+               << " (rejected: " << it->get_stats().rejected
+               << ", blocked: " << it->get_blocked_turns() << ")\n";
+        }
     }
     if (!any) os << "  (none)\n";
     os << "\n";
@@ -150,6 +244,20 @@ void Reports::print_simulation_state(const Factory& factory, Time t, std::ostrea
         any = true;
 
         os << "  • Storehouse " << it->get_id() << "\n";
+
+        const DeadlineStats& ds = it->get_deadline_stats();
+        if (ds.due > 0) {
+            os << "      tardiness  : late " << ds.late << "/" << ds.due
+               << " | mean " << static_cast<double>(ds.tardiness_sum) / ds.due
+               << " | max " << ds.max_tardiness << "\n";
+        }
+
+        auto summary = dynamic_cast<const PackageSummary*>(it->get_stockpile());
+        if (summary) {
+            print_stockpile_summary(os, *summary);
+            continue;
+        }
+
         os << "      stockpile  : ";
 
         bool empty_s = true;
@@ -163,3 +271,256 @@ void Reports::print_simulation_state(const Factory& factory, Time t, std::ostrea
     if (!any) os << "  (none)\n";
     os << "\n";
 }
+
+// =======================================================
+// Raport stanu ustalonego
+// =======================================================
+
+void Reports::print_steady_state(const SteadyStateResult& result, std::ostream& os) {
+    print_header(os, "STEADY STATE");
+
+    os << "  converged    : " << (result.converged ? "yes" : "no") << "\n"
+       << "  turns        : " << result.turns << "\n"
+       << "  warm-up      : " << result.warmup_turns << " turn(s)\n"
+       << "  batches      : " << result.batches << "\n"
+       << "  throughput   : " << result.throughput.mean
+       << " +/- " << result.throughput.half_width << " package(s)/turn\n"
+       << "  queue length : " << result.queue_length.mean
+       << " +/- " << result.queue_length.half_width << "\n\n";
+}
+
+void Reports::print_periodic_run(const PeriodicRunInfo& info, std::ostream& os) {
+    print_header(os, "PERIODIC RUN");
+
+    os << "  turns simulated : " << info.turns_simulated << "\n"
+       << "  extrapolated    : " << (info.extrapolated ? "yes" : "no") << "\n";
+    if (info.extrapolated) {
+        os << "  cycle start     : " << info.cycle_start << "\n"
+           << "  period          : " << info.period << " turn(s)\n"
+           << "  jump            : " << info.jump_from << " -> " << info.jump_to << "\n";
+    }
+    os << "\n";
+}
+
+// =======================================================
+// Podsumowanie przeglądu parametrów
+// =======================================================
+
+void Reports::print_sweep_summary(
+    const std::vector<SweepAxis>& axes,
+    const std::vector<SweepResult>& results,
+    std::ostream& os
+) {
+    os << "variant";
+    for (const auto& axis : axes) {
+        os << "," << sweep_axis_name(axis);
+    }
+    os << ",delivered,throughput,in-process,bottleneck,max-queue\n";
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const SweepResult& r = results[i];
+        os << i + 1;
+        for (std::size_t a = 0; a < axes.size(); ++a) {
+            os << "," << sweep_value_name(axes[a], r.values[a]);
+        }
+        os << "," << r.delivered
+           << "," << r.throughput
+           << "," << r.in_process
+           << "," << r.bottleneck
+           << "," << r.max_queue << "\n";
+    }
+}
+
+// =======================================================
+// Porównanie scenariuszy sparowanych
+// =======================================================
+
+static void print_paired_metric(std::ostream& os, const std::string& name, const PairedMetric& m) {
+    os << "  " << name << "\n"
+       << "      A          : " << m.a.mean << " +/- " << m.a.half_width << "\n"
+       << "      B          : " << m.b.mean << " +/- " << m.b.half_width << "\n"
+       << "      B - A      : " << m.difference.mean << " +/- " << m.difference.half_width << "\n"
+       << "      var ratio  : " << m.variance_ratio << "\n";
+}
+
+void Reports::print_paired_comparison(const PairedComparison& result, std::ostream& os) {
+    print_header(os, "PAIRED COMPARISON");
+
+    os << "  replications : " << result.replications << "\n"
+       << "  streams      : " << (result.common_random_numbers ? "common" : "independent") << "\n\n";
+
+    print_paired_metric(os, "throughput", result.throughput);
+    print_paired_metric(os, "in-process", result.in_process);
+    os << "\n";
+}
+
+// =======================================================
+// Oszacowanie analityczne
+// =======================================================
+
+void Reports::print_queueing_estimate(const QueueingEstimate& estimate, std::ostream& os) {
+    print_header(os, "QUEUEING ESTIMATE");
+
+    os << "  offered      : " << estimate.offered_rate << " package(s)/turn\n"
+       << "  throughput   : " << estimate.throughput << " package(s)/turn\n";
+    if (!estimate.converged) {
+        os << "  (not converged after " << estimate.iterations << " iteration(s))\n";
+    }
+    if (estimate.bounded_queues) {
+        os << "  (approximate: bounded queues, rerouting and blocking not modelled)\n";
+    }
+    os << "\n";
+
+    print_section(os, "Workers");
+    if (estimate.workers.empty()) os << "  (none)\n";
+    for (const WorkerLoad& w : estimate.workers) {
+        os << "  • Worker " << w.id
+           << "  lambda=" << w.arrival_rate
+           << "  mu=" << w.service_rate
+           << "  rho=" << w.utilization
+           << (w.saturated ? "  SATURATED" : "") << "\n";
+    }
+    os << "\n";
+
+    print_section(os, "Storehouses");
+    if (estimate.storehouses.empty()) os << "  (none)\n";
+    for (const StorehouseLoad& s : estimate.storehouses) {
+        os << "  • Storehouse " << s.id << "  lambda=" << s.arrival_rate << "\n";
+    }
+    os << "\n";
+}
+
+// =======================================================
+// Analiza wąskich gardeł
+// =======================================================
+
+static std::string chain_node_to_str(const ChainNode& n) {
+    switch (n.type) {
+        case ChainNodeType::RAMP:   return "ramp-" + std::to_string(n.id);
+        case ChainNodeType::WORKER: return "worker-" + std::to_string(n.id);
+        default:                    return "store-" + std::to_string(n.id);
+    }
+}
+
+static std::string limiting_chain_to_str(const BottleneckReport& report) {
+    std::string chain;
+    for (const ChainNode& n : report.limiting_chain) {
+        if (!chain.empty()) chain += " -> ";
+        chain += chain_node_to_str(n);
+    }
+    return chain;
+}
+
+void Reports::print_bottleneck_report(const BottleneckReport& report, std::ostream& os) {
+    print_header(os, "BOTTLENECKS");
+
+    os << "  turns        : " << report.turns << "\n";
+    if (report.ranking.empty()) {
+        os << "  (no workers)\n\n";
+        return;
+    }
+    os << "  bottleneck   : worker-" << report.bottleneck << "\n"
+       << "  chain        : " << limiting_chain_to_str(report) << "\n\n";
+
+    print_section(os, "Lead time ranking");
+    std::size_t rank = 0;
+    for (const WorkerUsage& u : report.ranking) {
+        os << "  " << ++rank << ". Worker " << u.id
+           << "  share=" << u.lead_time_share
+           << "  sojourn=" << u.mean_sojourn << "\n"
+           << "      busy=" << u.busy
+           << "  blocked=" << u.blocked
+           << "  idle=" << u.idle
+           << "  utilization=" << u.utilization
+           << "  processed=" << u.processed;
+        if (u.rejected > 0) os << "  rejected=" << u.rejected;
+        os << "\n";
+    }
+    os << "\n";
+}
+
+void Reports::write_bottleneck_csv(const BottleneckReport& report, std::ostream& os) {
+    os << "rank,worker,busy,blocked,idle,utilization,processed,residence,"
+          "mean-sojourn,lead-time-share,bottleneck\n";
+
+    std::size_t rank = 0;
+    for (const WorkerUsage& u : report.ranking) {
+        os << ++rank << "," << u.id
+           << "," << u.busy
+           << "," << u.blocked
+           << "," << u.idle
+           << "," << u.utilization
+           << "," << u.processed
+           << "," << u.residence
+           << "," << u.mean_sojourn
+           << "," << u.lead_time_share
+           << "," << (u.id == report.bottleneck ? 1 : 0) << "\n";
+    }
+    os << "# chain," << limiting_chain_to_str(report) << "\n";
+}
+
+void Reports::print_partition(const Factory& factory, const FactoryPartition& partition, std::ostream& os) {
+    print_header(os, "PARTITION");
+
+    os << "  parts        : " << partition.parts << "\n"
+       << "  cut links    : " << partition.cut_links << "\n\n";
+
+    for (std::size_t p = 0; p < partition.parts; ++p) {
+        os << "  Part " << p << ":";
+        std::size_t i = 0;
+        for (auto it = factory.ramp_cbegin(); it != factory.ramp_cend(); ++it, ++i) {
+            if (partition.ramps[i] == p) os << " ramp-" << it->get_id();
+        }
+        i = 0;
+        for (auto it = factory.worker_cbegin(); it != factory.worker_cend(); ++it, ++i) {
+            if (partition.workers[i] == p) os << " worker-" << it->get_id();
+        }
+        i = 0;
+        for (auto it = factory.storehouse_cbegin(); it != factory.storehouse_cend(); ++it, ++i) {
+            if (partition.storehouses[i] == p) os << " store-" << it->get_id();
+        }
+        os << "\n";
+    }
+    os << "\n";
+}
+
+void Reports::print_scheduler_stats(const std::vector<StealStats>& stats, std::ostream& os) {
+    print_header(os, "SCHEDULER");
+
+    for (std::size_t k = 0; k < stats.size(); ++k) {
+        const StealStats& st = stats[k];
+        os << "  Thread " << k
+           << "  tasks=" << st.tasks
+           << "  steals=" << st.steals
+           << "  failed-steals=" << st.failed_steals
+           << "  busy=" << st.busy_ms << " ms"
+           << "  idle=" << st.idle_ms << " ms\n";
+    }
+    os << "\n";
+}
+
+void Reports::print_rollback_stats(const std::vector<RollbackStats>& stats, std::ostream& os) {
+    print_header(os, "ROLLBACKS");
+
+    for (std::size_t p = 0; p < stats.size(); ++p) {
+        const RollbackStats& st = stats[p];
+        const double efficiency = (st.turns > 0)
+            ? 100.0 * (st.turns - st.rolled_back_turns) / st.turns
+            : 100.0;
+
+        os << "  Part " << p
+           << "  turns=" << st.turns
+           << "  rolled-back=" << st.rolled_back_turns
+           << "  coast=" << st.coast_turns
+           << "  efficiency=" << efficiency << "%\n"
+           << "    rollbacks=" << st.rollbacks
+           << " (straggler=" << st.straggler_rollbacks
+           << ", anti=" << st.anti_rollbacks << ")"
+           << "  messages=" << st.messages
+           << "  anti-messages=" << st.anti_messages
+           << "  annihilated=" << st.annihilated
+           << "  states=" << st.states_saved
+           << "  gvt-rounds=" << st.gvt_rounds << "\n";
+    }
+    os << "\n";
+}
@@ -8,13 +8,27 @@
 // Odpowiada za:
 // - raport struktury sieci
 // - raport stanu symulacji
+// - raport stanu ustalonego (simulate_until_steady)
+// - raport przeskoku okresów (simulate_periodic)
+// - podsumowanie przeglądu parametrów (run_sweep)
+// - porównanie scenariuszy sparowanych (compare_scenarios)
+// - analityczne oszacowanie obciążenia (analyze_queueing)
+// - analiza wąskich gardeł (analyze_bottlenecks), tekst i CSV
 //
 // Zgodne z PDF „Warstwa prezentacji danych”
 // ==============================
 
 #include <ostream>
 
-#include "factory/Factory.hpp"
+#include "Factory/factory.hpp"
+#include "Simulation/SteadyState.hpp"
+#include "Simulation/Periodic.hpp"
+#include "Simulation/Sweep.hpp"
+#include "Simulation/Paired.hpp"
+#include "Analysis/Queueing.hpp"
+#include "Analysis/Bottleneck.hpp"
+#include "Simulation/Partition.hpp"
+#include "Simulation/TimeWarp.hpp"
 
 // =======================================================
 // Namespace Reports
@@ -28,4 +42,38 @@ namespace Reports {
     // Raport stanu symulacji w danej turze
     void print_simulation_state(const Factory& factory, Time t, std::ostream& os);
 
+    // Raport estymacji stanu ustalonego
+    void print_steady_state(const SteadyStateResult& result, std::ostream& os);
+
+    // Raport wykrytego cyklu stanu i przeskoku do horyzontu
+    void print_periodic_run(const PeriodicRunInfo& info, std::ostream& os);
+
+    // Podsumowanie przeglądu: jeden wiersz CSV na wariant
+    void print_sweep_summary(
+        const std::vector<SweepAxis>& axes,
+        const std::vector<SweepResult>& results,
+        std::ostream& os
+    );
+
+    // Porównanie dwóch scenariuszy: średnie A, B i różnica sparowana
+    void print_paired_comparison(const PairedComparison& result, std::ostream& os);
+
+    // Oszacowanie analityczne: obciążenie robotników i napływ do magazynów
+    void print_queueing_estimate(const QueueingEstimate& estimate, std::ostream& os);
+
+    // Wąskie gardła: ranking robotników i łańcuch ograniczający
+    void print_bottleneck_report(const BottleneckReport& report, std::ostream& os);
+
+    // To samo w CSV: jeden wiersz na robotnika (kolejność rankingu)
+    void write_bottleneck_csv(const BottleneckReport& report, std::ostream& os);
+
+    // Podział fabryki na części: węzły części i krawędzie przecięte
+    void print_partition(const Factory& factory, const FactoryPartition& partition, std::ostream& os);
+
+    // Liczniki wątków puli z podkradaniem zadań
+    void print_scheduler_stats(const std::vector<StealStats>& stats, std::ostream& os);
+
+    // Liczniki cofnięć części symulacji optymistycznej
+    void print_rollback_stats(const std::vector<RollbackStats>& stats, std::ostream& os);
+
 }
@@ -0,0 +1,33 @@
+#include "Arena.hpp"
+
+#include "Package/Package.hpp"
+
+// =======================================================
+// SimulationArena
+// =======================================================
+
+SimulationArena::SimulationArena(std::size_t initial_size)
+    : monotonic_(initial_size), pool_(&monotonic_) {}
+
+std::pmr::memory_resource* SimulationArena::resource() {
+    return &pool_;
+}
+
+void SimulationArena::release() {
+    pool_.release();
+    monotonic_.release();
+}
+
+// =======================================================
+// ArenaScope
+// =======================================================
+
+ArenaScope::ArenaScope(SimulationArena& arena)
+    : previous_(std::pmr::set_default_resource(arena.resource())) {
+    Package::set_registry_resource(arena.resource());
+}
+
+ArenaScope::~ArenaScope() {
+    Package::set_registry_resource(previous_);
+    std::pmr::set_default_resource(previous_);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+// ==============================
+// Arena.hpp
+// ==============================
+// Arena pamięci dla jednej symulacji
+//
+// Odpowiada za:
+// - przydział węzłów list/map/zbiorów (kolejki, kolekcje węzłów,
+//   preferencje odbiorców, rejestr ID paczek) z jednego bufora
+// - zwolnienie całej pamięci przebiegu jednym wywołaniem
+//
+// Pool (synchronized_pool_resource) ponownie używa zwolnionych węzłów,
+// a nowe bloki pobiera z areny monotonicznej (przesunięcie wskaźnika).
+// Pool jest bezpieczny wątkowo i sam szereguje wywołania areny
+// monotonicznej -> z areny mogą korzystać wątki symulacji równoległych.
+// ==============================
+
+#include <cstddef>
+#include <memory_resource>
+
+// =======================================================
+// SimulationArena
+// =======================================================
+
+class SimulationArena {
+public:
+    explicit SimulationArena(std::size_t initial_size = 1 << 20);
+
+    SimulationArena(const SimulationArena&) = delete;
+    SimulationArena& operator=(const SimulationArena&) = delete;
+
+    std::pmr::memory_resource* resource();
+
+    // Zwalnia całą pamięć przebiegu
+    // (wszystkie obiekty korzystające z areny muszą już nie istnieć)
+    void release();
+
+private:
+    std::pmr::monotonic_buffer_resource monotonic_;
+    std::pmr::synchronized_pool_resource pool_;
+};
+
+// =======================================================
+// ArenaScope (RAII)
+// =======================================================
+//
+// Na czas życia obiektu arena jest domyślnym zasobem pmr,
+// więc Factory wczytana w tym zakresie alokuje wszystko w arenie.
+// Rejestr ID paczek (bieżącego wątku) również zostaje przeniesiony do areny
+// i wraca do poprzedniego zasobu przy wyjściu z zakresu.
+// Zasób domyślny jest wspólny dla procesu -> wątki uruchomione w zakresie
+// (run_sweep, simulate_parallel, simulate_optimistic) też alokują w arenie.
+//
+// Factory musi zostać zniszczona przed końcem zakresu.
+//
+class ArenaScope {
+public:
+    explicit ArenaScope(SimulationArena& arena);
+    ~ArenaScope();
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    std::pmr::memory_resource* previous_;
+};
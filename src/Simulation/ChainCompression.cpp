@@ -0,0 +1,290 @@
+#include "ChainCompression.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+// =======================================================
+// Funkcje pomocnicze
+// =======================================================
+
+// etap łańcucha: kolejka FIFO i jedno stanowisko bez partii
+static bool is_fifo(const Worker& w) {
+    return w.get_queue()->getQueueType() == PackageQueueType::FIFO && !w.is_multi_server() &&
+           w.get_processing_stream().get_distribution().is_fixed();
+}
+
+static RandomStream* stream_of(Worker* w) {
+    return w->receiver_preferences.get_probability_generator().target<RandomStream>();
+}
+
+// =======================================================
+// Wykrywanie łańcuchów
+// =======================================================
+
+ChainCompressor::ChainCompressor(Factory& f) : factory_(f) {
+    std::vector<Worker*> workers;
+    std::unordered_map<const IPackageReceiver*, std::size_t> index;
+    for (auto it = f.worker_begin(); it != f.worker_end(); ++it) {
+        index.emplace(&*it, workers.size());
+        workers.push_back(&*it);
+    }
+
+    // ograniczone kolejki: przekazanie zależy od zajętości odbiorców,
+    // czego rekurencja czasów łańcucha nie modeluje -> brak łańcuchów
+    for (Worker* w : workers) {
+        if (w->get_queue_capacity() > 0) return;
+    }
+
+    const std::size_t n = workers.size();
+    const std::size_t none = n;
+
+    // liczba nadawców każdego robotnika
+    std::vector<std::size_t> indegree(n, 0);
+    auto count_inputs = [&](const PackageSender& s) {
+        for (const auto& pref : s.receiver_preferences) {
+            auto w = index.find(pref.first);
+            if (w != index.end()) ++indegree[w->second];
+        }
+    };
+    for (auto it = f.ramp_cbegin(); it != f.ramp_cend(); ++it) count_inputs(*it);
+    for (Worker* w : workers) count_inputs(*w);
+
+    // krawędzie łańcucha: jedyny odbiorca -> robotnik z jedynym nadawcą
+    std::vector<std::size_t> next(n, none);
+    std::vector<char> has_prev(n, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto& prefs = workers[i]->receiver_preferences.get_preferences();
+        if (prefs.size() != 1 || !is_fifo(*workers[i])) continue;
+
+        auto w = index.find(prefs.begin()->first);
+        if (w == index.end() || w->second == i) continue;
+        if (indegree[w->second] != 1 || !is_fifo(*workers[w->second])) continue;
+
+        next[i] = w->second;
+        has_prev[w->second] = 1;
+    }
+
+    // łańcuchy maksymalne (od robotnika bez poprzednika w łańcuchu)
+    for (std::size_t i = 0; i < n; ++i) {
+        if (has_prev[i] || next[i] == none) continue;
+
+        chains_.emplace_back();
+        Chain& c = chains_.back();
+        for (std::size_t w = i; w != none; w = next[w]) {
+            c.stages.push_back(workers[w]);
+            TimeOffset pd = workers[w]->get_processing_duration();
+            c.duration.push_back(pd > 0 ? pd : 1);
+        }
+        const std::size_t k = c.stages.size();
+        c.free.assign(k, 0);
+        c.position.assign(k, 0);
+        c.sends.assign(k, 0);
+        c.stats.assign(k, WorkerStats{});
+    }
+}
+
+std::vector<std::vector<ElementID>> ChainCompressor::chains() const {
+    std::vector<std::vector<ElementID>> ids;
+    for (const Chain& c : chains_) {
+        std::vector<ElementID> chain;
+        for (const Worker* w : c.stages) {
+            chain.push_back(w->get_id());
+        }
+        ids.push_back(std::move(chain));
+    }
+    return ids;
+}
+
+bool ChainCompressor::is_collapsed() const {
+    return collapsed_;
+}
+
+// =======================================================
+// Rekurencja czasów
+// =======================================================
+
+void ChainCompressor::schedule(Chain& c, InFlight& p, std::size_t i, Time a) {
+    for (std::size_t j = i; j < c.stages.size(); ++j) {
+        Time s = std::max(a, c.free[j] + 1);
+        Time f = s + c.duration[j] - 1;
+        p.start[j] = s;
+        p.finish[j] = f;
+        c.free[j] = f;
+        a = f + 1;
+    }
+}
+
+void ChainCompressor::account(Chain& c, InFlight& p, Time t) {
+    const std::size_t last_event = 2 * (c.stages.size() - 1);
+    for (; p.next_event <= last_event; ++p.next_event) {
+        const std::size_t j = p.next_event / 2;
+        if (p.next_event % 2 == 0) {
+            // koniec obróbki na etapie j (jak Worker::finish_processing)
+            if (p.finish[j] > t) return;
+            WorkerStats& st = c.stats[j];
+            ++st.processed;
+            st.busy_turns += c.duration[j];
+            st.departure_time_sum += p.finish[j] + 1;
+        } else {
+            // przybycie do etapu j + 1 (przekazanie w turze f_j + 1)
+            Time a = p.finish[j] + 1;
+            if (a > t) return;
+            WorkerStats& st = c.stats[j + 1];
+            ++st.received;
+            st.arrival_time_sum += a;
+        }
+    }
+}
+
+// =======================================================
+// Zwinięcie stanu robotników
+// =======================================================
+
+void ChainCompressor::collapse(Time t) {
+    if (collapsed_) {
+        throw std::logic_error("Chains are already collapsed");
+    }
+
+    for (Chain& c : chains_) {
+        const std::size_t k = c.stages.size();
+        std::fill(c.free.begin(), c.free.end(), t);
+
+        for (std::size_t i = 0; i + 1 < k; ++i) {
+            RandomStream* stream = stream_of(c.stages[i]);
+            c.position[i] = stream ? stream->get_position() : 0;
+            c.sends[i] = 0;
+        }
+
+        // next_event: zdarzenia sprzed collapse są już w WorkerStats robotników
+        auto make = [k](Package&& p, std::size_t entry) {
+            return InFlight{std::move(p), entry, 2 * entry,
+                            std::vector<Time>(k), std::vector<Time>(k)};
+        };
+
+        // od najstarszej: etap k-1 ... etap 0 (obróbka, kolejka, bufor poprzednika)
+        for (std::size_t i = k; i-- > 0;) {
+            Worker* w = c.stages[i];
+
+            if (w->is_processing()) {
+                Time s = w->get_package_processing_start_time();
+                InFlight p = make(w->release_processing(), i);
+                p.start[i] = s;
+                p.finish[i] = std::max(s + c.duration[i] - 1, t + 1);
+                c.free[i] = p.finish[i];
+                schedule(c, p, i + 1, p.finish[i] + 1);
+                c.in_flight.push_back(std::move(p));
+            }
+
+            while (!w->get_queue()->empty()) {
+                InFlight p = make(w->get_queue()->pop(), i);
+                schedule(c, p, i, t + 1);
+                c.in_flight.push_back(std::move(p));
+            }
+
+            // bufor poprzednika: wysłanie do etapu i w turze t + 1
+            if (i > 0 && c.stages[i - 1]->has_package()) {
+                InFlight p = make(c.stages[i - 1]->take_package(), i - 1);
+                p.next_event = 2 * (i - 1) + 1;
+                p.start[i - 1] = t;
+                p.finish[i - 1] = t;
+                schedule(c, p, i, t + 1);
+                c.in_flight.push_back(std::move(p));
+            }
+        }
+    }
+
+    collapsed_ = true;
+}
+
+// =======================================================
+// Rozwinięcie stanu do robotników
+// =======================================================
+
+void ChainCompressor::expand(Time t) {
+    if (!collapsed_) {
+        throw std::logic_error("Chains are not collapsed");
+    }
+
+    for (Chain& c : chains_) {
+        const std::size_t k = c.stages.size();
+        std::vector<std::uint64_t> sends = c.sends;
+
+        for (InFlight& p : c.in_flight) {
+            account(c, p, t);
+
+            // pierwszy etap, którego paczka jeszcze nie opuściła
+            std::size_t i = p.entry;
+            while (p.finish[i] < t) {
+                if (i + 1 < k) ++sends[i];
+                ++i;
+            }
+
+            Worker* w = c.stages[i];
+            if (p.finish[i] == t) {
+                w->push_package(std::move(p.package));            // bufor
+            } else if (p.start[i] <= t) {
+                w->restore_processing(std::move(p.package), p.start[i], w->get_processing_duration());
+            } else {
+                w->restore_queued(std::move(p.package));         // zgłasza robotnika
+            }
+        }
+        c.in_flight.clear();
+
+        for (std::size_t i = 0; i < k; ++i) {
+            WorkerStats st = c.stages[i]->get_stats();
+            const WorkerStats& d = c.stats[i];
+            st.received += d.received;
+            st.processed += d.processed;
+            st.busy_turns += d.busy_turns;
+            st.arrival_time_sum += d.arrival_time_sum;
+            st.departure_time_sum += d.departure_time_sum;
+            c.stages[i]->restore_stats(st);
+            c.stats[i] = WorkerStats{};
+        }
+
+        for (std::size_t i = 0; i + 1 < k; ++i) {
+            RandomStream* stream = stream_of(c.stages[i]);
+            if (stream) stream->set_position(c.position[i] + sends[i]);
+        }
+    }
+
+    collapsed_ = false;
+}
+
+// =======================================================
+// Praca w trybie zwiniętym
+// =======================================================
+
+void ChainCompressor::do_work(Time t) {
+    if (!collapsed_) {
+        throw std::logic_error("Chains are not collapsed");
+    }
+
+    // nowe paczki w kolejce pierwszego etapu -> czasy całego łańcucha
+    for (Chain& c : chains_) {
+        IPackageQueue* head = c.stages.front()->get_queue();
+        const std::size_t k = c.stages.size();
+        while (!head->empty()) {
+            InFlight p{head->pop(), 0, 0, std::vector<Time>(k), std::vector<Time>(k)};
+            schedule(c, p, 0, t);
+            c.in_flight.push_back(std::move(p));
+        }
+    }
+
+    factory_.do_work(t);
+
+    // koniec ostatniego etapu -> bufor ostatniego robotnika
+    for (Chain& c : chains_) {
+        const std::size_t last = c.stages.size() - 1;
+        while (!c.in_flight.empty() && c.in_flight.front().finish[last] <= t) {
+            InFlight& p = c.in_flight.front();
+            account(c, p, t);
+            for (std::size_t i = p.entry; i < last; ++i) {
+                ++c.sends[i];
+            }
+            c.stages[last]->push_package(std::move(p.package));
+            c.in_flight.pop_front();
+        }
+    }
+}
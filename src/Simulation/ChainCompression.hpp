@@ -0,0 +1,91 @@
+#pragma once
+
+// ==============================
+// ChainCompression.hpp
+// ==============================
+// Kompresja łańcuchów robotników FIFO
+//
+// Łańcuch: robotnicy w_1 -> w_2 -> ... -> w_k (k >= 2), wszyscy FIFO
+// z jednym stanowiskiem bez partii (servers = batch = 1) i stałym czasem obróbki,
+// w_1..w_{k-1} mają dokładnie jednego odbiorcę (kolejnego robotnika),
+// a w_2..w_k dokładnie jednego nadawcę (poprzedniego robotnika).
+// Wejście w_1 i wyjście w_k są dowolne (granice łańcucha).
+//
+// Dla takiego łańcucha czasy są dane rekurencją (max-plus):
+//   a_1     = tura przybycia do kolejki w_1
+//   s_i     = max(a_i, f_i(poprzednia paczka) + 1)
+//   f_i     = s_i + max(pd_i, 1) - 1
+//   a_{i+1} = f_i + 1
+// więc węzeł złożony liczy czasy paczki raz, przy wejściu, i oddaje ją
+// do bufora w_k w turze f_k -> na granicach przebieg jest identyczny
+// (te same paczki w tych samych turach, generator w_k bez zmian).
+//
+// Stan wewnętrzny (kolejki, obróbka, bufory, pozycje strumieni RandomStream
+// robotników wewnętrznych) można odtworzyć w robotnikach przez expand()
+// i ponownie zwinąć przez collapse(). WorkerStats robotników łańcucha
+// są uzupełniane przy expand() zdarzeniami z czasów rekurencji
+// (przybycie a_i, koniec obróbki f_i).
+//
+// Kompresor trzeba zbudować ponownie po zmianie topologii.
+// Fabryka z ograniczonymi kolejkami (queue-capacity) nie ma łańcuchów.
+// ==============================
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "Factory/factory.hpp"
+
+// =======================================================
+// ChainCompressor
+// =======================================================
+
+class ChainCompressor {
+public:
+    explicit ChainCompressor(Factory& f);
+
+    // ID robotników kolejnych łańcuchów
+    std::vector<std::vector<ElementID>> chains() const;
+
+    // Stan robotników łańcuchów -> węzły złożone (po zakończeniu tury t)
+    void collapse(Time t);
+
+    // Węzły złożone -> stan robotników (po zakończeniu tury t)
+    void expand(Time t);
+
+    bool is_collapsed() const;
+
+    // Odpowiednik Factory::do_work(t) (wymaga stanu zwiniętego)
+    void do_work(Time t);
+
+private:
+    // Paczka w łańcuchu: czasy od etapu entry do końca
+    struct InFlight {
+        Package package;
+        std::size_t entry;          // pierwszy etap z oczekującym wysłaniem
+        std::size_t next_event;     // pierwsze zdarzenie niewliczone do WorkerStats
+                                    // (2j -> koniec obróbki j, 2j+1 -> przybycie do j+1)
+        std::vector<Time> start;    // s_i (indeks etapu)
+        std::vector<Time> finish;   // f_i
+    };
+
+    struct Chain {
+        std::vector<Worker*> stages;
+        std::vector<TimeOffset> duration;       // max(pd, 1)
+        std::vector<Time> free;                 // f ostatniej paczki na etapie
+        std::vector<std::uint64_t> position;    // pozycja strumienia przy collapse
+        std::vector<std::uint64_t> sends;       // wysłania od collapse
+        std::vector<WorkerStats> stats;         // zdarzenia od collapse (do expand)
+        std::deque<InFlight> in_flight;         // od najstarszej
+    };
+
+    // Wyznacza czasy od etapu i (przybycie w turze a)
+    void schedule(Chain& c, InFlight& p, std::size_t i, Time a);
+
+    // Dolicza do c.stats zdarzenia paczki z turą <= t
+    void account(Chain& c, InFlight& p, Time t);
+
+    Factory& factory_;
+    std::deque<Chain> chains_;   // deque: Chain nie jest kopiowalny (paczki)
+    bool collapsed_ = false;
+};
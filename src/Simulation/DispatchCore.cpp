@@ -0,0 +1,64 @@
+#include "DispatchCore.hpp"
+#include "io/Parser.hpp"
+
+#include <chrono>
+#include <sstream>
+
+// =======================================================
+// Przekazywanie paczek
+// =======================================================
+
+DispatchCore::DispatchCore(Factory& f) : factory_(f) {
+    // kompilacja obrazu przed pierwszą turą
+    f.snapshot();
+}
+
+void DispatchCore::do_package_passing() {
+    const FactorySnapshot& snap = factory_.snapshot();
+    for (std::size_t i = 0; i < snap.senders().size(); ++i) {
+        snap.send(i);
+    }
+}
+
+// =======================================================
+// Benchmark
+// =======================================================
+
+// Oba warianty przechodzą wszystkich nadawców obrazu po kolei; różnią się
+// tylko wywołaniem: wirtualne send_package vs FactorySnapshot::send
+DispatchBenchmark benchmark_dispatch(const std::string& topology, TimeOffset d) {
+    auto run = [&](bool handles) {
+        std::istringstream is(topology);
+        Factory f = IO::load_factory_structure(is);
+        if (!f.is_consistent()) {
+            throw std::logic_error("Factory network is not consistent");
+        }
+        DispatchCore core(f);
+
+        auto start = std::chrono::steady_clock::now();
+        for (Time t = 1; t <= d; ++t) {
+            f.do_deliveries(t);
+            if (handles) {
+                core.do_package_passing();
+            } else {
+                for (PackageSender* s : f.snapshot().senders()) s->send_package();
+            }
+            f.do_work(t);
+        }
+        auto stop = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::milli>(stop - start).count();
+    };
+
+    // rozgrzewka (pamięć podręczna, alokator), potem kolejność V H H V,
+    // żeby żaden wariant nie zyskiwał na pozycji w pomiarze
+    run(false);
+    run(true);
+
+    DispatchBenchmark result;
+    result.virtual_ms = run(false);
+    result.handles_ms = run(true);
+    result.handles_ms = (result.handles_ms + run(true)) / 2.0;
+    result.virtual_ms = (result.virtual_ms + run(false)) / 2.0;
+    return result;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+// ==============================
+// DispatchCore.hpp
+// ==============================
+// Przekazywanie paczek bez wywołań wirtualnych
+//
+// Odpowiada za:
+// - przekazywanie paczek wszystkich nadawców po kolei (bez zbiorów
+//   aktywnych) na skompilowanym obrazie fabryki (FactorySnapshot):
+//   uchwyty odbiorców, tablice wag CSR, switch po rodzaju węzła
+// - benchmark: wirtualne PackageSender::send_package vs obraz CSR
+//
+// Uchwyty i tablice wag należą do FactorySnapshot (Factory/Snapshot.hpp);
+// Factory::do_package_passing używa tego samego obrazu.
+// ==============================
+
+#include <string>
+
+#include "Factory/factory.hpp"
+
+// =======================================================
+// DispatchCore
+// =======================================================
+
+class DispatchCore {
+public:
+    explicit DispatchCore(Factory& f);
+
+    // Odpowiednik Factory::do_package_passing()
+    void do_package_passing();
+
+private:
+    Factory& factory_;
+};
+
+// =======================================================
+// Benchmark: wirtualne przekazywanie vs uchwyty
+// =======================================================
+
+struct DispatchBenchmark {
+    double virtual_ms;   // PackageSender::send_package (IPackageReceiver*)
+    double handles_ms;   // Factory::do_package_passing (FactorySnapshot)
+};
+
+// Mierzy d tur każdym wariantem (ci sami nadawcy w obu); jeden przebieg
+// rozgrzewki na wariant, potem średnia z dwóch w kolejności V H H V
+DispatchBenchmark benchmark_dispatch(const std::string& topology, TimeOffset d);
@@ -0,0 +1,115 @@
+#include "Paired.hpp"
+#include "Simulation.hpp"
+#include "Sweep.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+// =======================================================
+// Strumienie nadawców
+// =======================================================
+
+// Klucz nadawcy: rampy i robotnicy mogą mieć te same ID
+static std::uint64_t sender_key(ElementID id, bool worker) {
+    return static_cast<std::uint64_t>(static_cast<std::uint32_t>(id)) * 2 + (worker ? 1 : 0);
+}
+
+// Strumień czasów węzła: klucz nadawcy z najstarszym bitem (osobny od wyboru odbiorcy)
+static std::uint64_t time_key(ElementID id, bool worker) {
+    return sender_key(id, worker) | (1ULL << 63);
+}
+
+void assign_random_streams(FactoryDraft& draft, std::uint64_t seed) {
+    for (auto& r : draft.ramps) {
+        r.seeded = true;
+        r.routing_seed = RandomStream::derive_seed(seed, sender_key(r.id, false));
+        r.time_seeded = true;
+        r.time_seed = RandomStream::derive_seed(seed, time_key(r.id, false));
+    }
+    for (auto& w : draft.workers) {
+        w.seeded = true;
+        w.routing_seed = RandomStream::derive_seed(seed, sender_key(w.id, true));
+        w.time_seeded = true;
+        w.time_seed = RandomStream::derive_seed(seed, time_key(w.id, true));
+    }
+}
+
+// =======================================================
+// Funkcje pomocnicze
+// =======================================================
+
+static SweepResult run_once(const FactoryDraft& draft, TimeOffset turns) {
+    Package::load_registry({}, {});
+    SweepResult r;
+    {
+        Factory f = IO::build_factory(draft);
+        simulate(f, turns, [](Factory&, Time) {});
+        r = summarize_run(f, turns);
+    }
+    Package::load_registry({}, {});
+    return r;
+}
+
+static PairedMetric pair(
+    const std::vector<double>& a,
+    const std::vector<double>& b,
+    double confidence
+) {
+    std::vector<double> diff(a.size());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        diff[i] = b[i] - a[i];
+    }
+
+    PairedMetric m;
+    m.a = estimate_mean(a, confidence);
+    m.b = estimate_mean(b, confidence);
+    m.difference = estimate_mean(diff, confidence);
+
+    double independent = m.a.variance + m.b.variance;
+    m.variance_ratio = (independent > 0.0) ? m.difference.variance / independent : 0.0;
+    return m;
+}
+
+// =======================================================
+// Funkcja compare_scenarios()
+// =======================================================
+
+PairedComparison compare_scenarios(
+    const FactoryDraft& a,
+    const FactoryDraft& b,
+    const PairedOptions& options
+) {
+    if (options.replications < 2) {
+        throw std::invalid_argument("Paired comparison needs at least 2 replications");
+    }
+
+    // ziarna scenariuszy: wspólne (CRN) albo rozłączne
+    const std::uint64_t seed_a = RandomStream::derive_seed(options.base_seed, 0);
+    const std::uint64_t seed_b = options.common_random_numbers
+        ? seed_a
+        : RandomStream::derive_seed(options.base_seed, 1);
+
+    std::vector<double> thr_a, thr_b, wip_a, wip_b;
+    FactoryDraft draft_a = a;
+    FactoryDraft draft_b = b;
+
+    for (std::size_t r = 0; r < options.replications; ++r) {
+        assign_random_streams(draft_a, RandomStream::derive_seed(seed_a, r));
+        assign_random_streams(draft_b, RandomStream::derive_seed(seed_b, r));
+
+        SweepResult ra = run_once(draft_a, options.turns);
+        SweepResult rb = run_once(draft_b, options.turns);
+
+        thr_a.push_back(ra.throughput);
+        thr_b.push_back(rb.throughput);
+        wip_a.push_back(static_cast<double>(ra.in_process));
+        wip_b.push_back(static_cast<double>(rb.in_process));
+    }
+
+    PairedComparison result;
+    result.replications = options.replications;
+    result.common_random_numbers = options.common_random_numbers;
+    result.throughput = pair(thr_a, thr_b, options.confidence);
+    result.in_process = pair(wip_a, wip_b, options.confidence);
+    return result;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+// ==============================
+// Paired.hpp
+// ==============================
+// Porównanie dwóch scenariuszy na wspólnych liczbach losowych (CRN)
+//
+// Odpowiada za:
+// - przydział strumieni RandomStream nadawcom: ziarno zależy tylko od
+//   (ziarno replikacji, typ i ID nadawcy), więc ten sam nadawca w obu
+//   wariantach pobiera te same liczby na tych samych pozycjach strumienia
+//   (także strumienie czasów losowych obróbki i dostaw)
+// - replikacje par (A, B) i statystyki różnic sparowanych
+//
+// Wariancja różnicy przy CRN jest zwykle dużo mniejsza niż suma wariancji
+// (przypadek strumieni niezależnych), więc do tej samej szerokości
+// przedziału ufności wystarcza mniej replikacji. variance_ratio w wyniku
+// pokazuje ten stosunek.
+//
+// Przebiegi wykonywane są w bieżącym wątku; rejestr ID paczek wątku
+// jest zerowany przed każdym przebiegiem.
+// ==============================
+
+#include <cstddef>
+#include <cstdint>
+
+#include "io/Parser.hpp"
+#include "Simulation/Statistics.hpp"
+
+// =======================================================
+// Strumienie nadawców
+// =======================================================
+
+// Każdy nadawca (rampa, robotnik) dostaje routing-seed i time-seed pochodne od seed
+void assign_random_streams(FactoryDraft& draft, std::uint64_t seed);
+
+// =======================================================
+// Parametry i wynik
+// =======================================================
+
+struct PairedOptions {
+    TimeOffset turns = 1000;
+    std::size_t replications = 30;
+    std::uint64_t base_seed = 1;
+    double confidence = 0.95;
+    bool common_random_numbers = true;   // false -> strumienie niezależne (odniesienie)
+};
+
+struct PairedMetric {
+    MeanEstimate a;             // scenariusz A
+    MeanEstimate b;             // scenariusz B
+    MeanEstimate difference;    // B - A (pary z tej samej replikacji)
+    double variance_ratio = 0.0; // var(B - A) / (var(A) + var(B))
+};
+
+struct PairedComparison {
+    std::size_t replications = 0;
+    bool common_random_numbers = true;
+    PairedMetric throughput;    // paczki do magazynów na turę
+    PairedMetric in_process;    // paczki w obiegu po ostatniej turze
+};
+
+// =======================================================
+// Funkcja compare_scenarios()
+// =======================================================
+
+PairedComparison compare_scenarios(
+    const FactoryDraft& a,
+    const FactoryDraft& b,
+    const PairedOptions& options
+);
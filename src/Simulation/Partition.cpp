@@ -0,0 +1,584 @@
+#include "Partition.hpp"
+#include "io/Checkpoint.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// =======================================================
+// Podział grafu
+// =======================================================
+
+FactoryPartition partition_factory(const Factory& f, std::size_t parts, double balance) {
+    if (parts == 0) {
+        throw std::invalid_argument("Number of parts must be positive");
+    }
+
+    // indeksy globalne: rampy, robotnicy, magazyny
+    std::unordered_map<const IPackageReceiver*, std::size_t> index;
+    std::vector<const PackageSender*> senders;
+    for (auto it = f.ramp_cbegin(); it != f.ramp_cend(); ++it) {
+        senders.push_back(&*it);
+    }
+    const std::size_t ramp_count = senders.size();
+    for (auto it = f.worker_cbegin(); it != f.worker_cend(); ++it) {
+        index.emplace(&*it, senders.size());
+        senders.push_back(&*it);
+    }
+    const std::size_t worker_count = senders.size() - ramp_count;
+    std::size_t n = senders.size();
+    for (auto it = f.storehouse_cbegin(); it != f.storehouse_cend(); ++it) {
+        index.emplace(&*it, n++);
+    }
+
+    // krawędzie LINK (graf nieskierowany do liczenia cięcia)
+    std::vector<std::pair<std::size_t, std::size_t>> links;
+    std::vector<std::vector<std::size_t>> adj(n);
+    for (std::size_t u = 0; u < senders.size(); ++u) {
+        for (const auto& pref : senders[u]->receiver_preferences) {
+            auto v = index.find(pref.first);
+            if (v == index.end()) continue;
+            links.emplace_back(u, v->second);
+            adj[u].push_back(v->second);
+            adj[v->second].push_back(u);
+        }
+    }
+
+    // kolejność BFS od ramp -> sąsiedzi trafiają do tej samej części
+    std::vector<std::size_t> order;
+    std::vector<char> seen(n, 0);
+    for (std::size_t s = 0; s < n; ++s) {
+        if (seen[s]) continue;
+        std::queue<std::size_t> q;
+        q.push(s);
+        seen[s] = 1;
+        while (!q.empty()) {
+            std::size_t u = q.front();
+            q.pop();
+            order.push_back(u);
+            for (std::size_t v : adj[u]) {
+                if (!seen[v]) {
+                    seen[v] = 1;
+                    q.push(v);
+                }
+            }
+        }
+    }
+
+    const std::size_t cap = std::max<std::size_t>(1, (n + parts - 1) / parts);
+    const std::size_t limit = std::max(cap,
+        static_cast<std::size_t>(std::ceil((1.0 + balance) * n / parts)));
+
+    std::vector<std::size_t> part(n), sizes(parts, 0);
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        part[order[i]] = std::min(i / cap, parts - 1);
+        ++sizes[part[order[i]]];
+    }
+
+    // poprawki: węzeł przechodzi do części z większą liczbą sąsiadów
+    std::vector<std::size_t> conn(parts, 0);
+    for (int pass = 0; pass < 10; ++pass) {
+        bool moved = false;
+        for (std::size_t v = 0; v < n; ++v) {
+            for (std::size_t u : adj[v]) ++conn[part[u]];
+
+            std::size_t cur = part[v], best = cur;
+            for (std::size_t u : adj[v]) {
+                std::size_t q = part[u];
+                if (conn[q] > conn[best] && sizes[q] < limit) best = q;
+            }
+            for (std::size_t u : adj[v]) conn[part[u]] = 0;
+
+            if (best != cur && sizes[cur] > 1) {
+                --sizes[cur];
+                ++sizes[best];
+                part[v] = best;
+                moved = true;
+            }
+        }
+        if (!moved) break;
+    }
+
+    FactoryPartition result;
+    result.parts = parts;
+    result.ramps.assign(part.begin(), part.begin() + ramp_count);
+    result.workers.assign(part.begin() + ramp_count, part.begin() + ramp_count + worker_count);
+    result.storehouses.assign(part.begin() + ramp_count + worker_count, part.end());
+    for (const auto& link : links) {
+        if (part[link.first] != part[link.second]) ++result.cut_links;
+    }
+    return result;
+}
+
+// =======================================================
+// Pamięć współdzielona
+// =======================================================
+
+// Paczka przekazywana do innej części
+struct Transfer {
+    Time turn;
+    std::uint32_t sender;       // indeks nadawcy w FactorySnapshot
+    ReceiverHandle receiver;
+    ElementID package;
+    int priority;
+    Time deadline;
+};
+
+// Pierścień: jeden proces pisze, jeden czyta (sloty zaraz za nagłówkiem)
+struct Ring {
+    std::atomic<std::uint64_t> head;   // następny zapis
+    std::atomic<std::uint64_t> tail;   // następny odczyt
+    std::uint64_t capacity;
+
+    Transfer* slots() { return reinterpret_cast<Transfer*>(this + 1); }
+
+    void push(const Transfer& x) {
+        std::uint64_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == capacity) {
+            throw std::logic_error("Partition ring overflow");
+        }
+        slots()[h % capacity] = x;
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    // Zdejmuje paczkę wysłaną w turze turn (nowsze zostają)
+    bool pop(Time turn, Transfer& x) {
+        std::uint64_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) return false;
+        const Transfer& front = slots()[t % capacity];
+        if (front.turn != turn) return false;
+        x = front;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "Ring counters must be lock-free to live in shared memory");
+
+static constexpr std::size_t CACHE_LINE = 64;
+
+static std::size_t align_up(std::size_t n) {
+    return (n + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+}
+
+// Region mmap(MAP_SHARED) dziedziczony przez procesy potomne
+class SharedRegion {
+public:
+    explicit SharedRegion(std::size_t bytes) : size_(bytes) {
+        void* p = mmap(nullptr, size_, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            throw std::runtime_error("Cannot map shared memory");
+        }
+        data_ = static_cast<char*>(p);
+    }
+    ~SharedRegion() { munmap(data_, size_); }
+
+    SharedRegion(const SharedRegion&) = delete;
+    SharedRegion& operator=(const SharedRegion&) = delete;
+
+    char* data() { return data_; }
+
+private:
+    std::size_t size_;
+    char* data_;
+};
+
+// Bariera tur + pierścienie (p -> q) dla każdej pary części
+class Exchange {
+public:
+    Exchange(std::size_t parts, const std::vector<std::size_t>& capacities)
+        : parts_(parts), offsets_(parts * parts),
+          region_(layout(parts, capacities, offsets_)) {
+        pthread_barrierattr_t attr;
+        pthread_barrierattr_init(&attr);
+        pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+        int rc = pthread_barrier_init(barrier(), &attr, static_cast<unsigned>(parts));
+        pthread_barrierattr_destroy(&attr);
+        if (rc != 0) {
+            throw std::runtime_error("Cannot create process-shared barrier");
+        }
+
+        for (std::size_t i = 0; i < offsets_.size(); ++i) {
+            Ring* r = new (region_.data() + offsets_[i]) Ring;
+            r->head.store(0);
+            r->tail.store(0);
+            r->capacity = capacities[i];
+        }
+    }
+    ~Exchange() { pthread_barrier_destroy(barrier()); }
+
+    Ring& ring(std::size_t from, std::size_t to) {
+        return *reinterpret_cast<Ring*>(region_.data() + offsets_[from * parts_ + to]);
+    }
+
+    void wait() { pthread_barrier_wait(barrier()); }
+
+private:
+    static std::size_t layout(std::size_t parts, const std::vector<std::size_t>& capacities,
+                              std::vector<std::size_t>& offsets) {
+        std::size_t bytes = align_up(sizeof(pthread_barrier_t));
+        for (std::size_t i = 0; i < parts * parts; ++i) {
+            offsets[i] = bytes;
+            bytes += align_up(sizeof(Ring) + capacities[i] * sizeof(Transfer));
+        }
+        return bytes;
+    }
+
+    pthread_barrier_t* barrier() {
+        return reinterpret_cast<pthread_barrier_t*>(region_.data());
+    }
+
+    std::size_t parts_;
+    std::vector<std::size_t> offsets_;
+    SharedRegion region_;
+};
+
+// =======================================================
+// Proces części
+// =======================================================
+
+// Paczka do dostarczenia w bieżącej turze
+struct Delivery {
+    std::uint32_t sender;
+    ReceiverHandle receiver;
+    Package package;
+};
+
+struct PartContext {
+    std::size_t me;
+    std::size_t parts;
+    TimeOffset d;
+    TimeOffset report_every;
+    std::vector<std::size_t> sender_part;   // indeks nadawcy -> część
+    std::vector<std::size_t> worker_part;
+    std::vector<std::size_t> storehouse_part;
+};
+
+static bool is_report_turn(Time t, TimeOffset d, TimeOffset report_every) {
+    return t == d || (report_every > 0 && t % report_every == 0);
+}
+
+static void write_all(int fd, const char* data, std::size_t n) {
+    while (n > 0) {
+        ssize_t k = ::write(fd, data, n);
+        if (k < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Cannot write partition state");
+        }
+        data += k;
+        n -= static_cast<std::size_t>(k);
+    }
+}
+
+// Stan części (checkpoint) -> potok: długość + bajty
+static void send_state(const Factory& f, Time t, int fd) {
+    std::ostringstream os;
+    IO::save_checkpoint(f, t, os);
+    const std::string blob = os.str();
+    const std::uint64_t size = blob.size();
+    write_all(fd, reinterpret_cast<const char*>(&size), sizeof size);
+    write_all(fd, blob.data(), blob.size());
+}
+
+static void run_part(Factory& f, const PartContext& ctx, Exchange& ex, int out) {
+    const FactorySnapshot& snap = f.snapshot();
+    const std::size_t me = ctx.me;
+    const std::size_t parts = ctx.parts;
+
+    auto owner = [&](ReceiverHandle h) {
+        return (h.type == ReceiverType::WORKER) ? ctx.worker_part[h.index]
+                                                : ctx.storehouse_part[h.index];
+    };
+
+    // stan węzłów spoza części należy do innych procesów
+    std::vector<std::size_t> senders;
+    std::vector<Ramp*> foreign_ramps;
+    for (std::size_t i = 0; i < snap.senders().size(); ++i) {
+        if (ctx.sender_part[i] == me) {
+            senders.push_back(i);
+        } else if (i < snap.ramps().size()) {
+            foreign_ramps.push_back(snap.ramps()[i]);
+        }
+        PackageSender* s = snap.senders()[i];
+        if (ctx.sender_part[i] != me && s->has_package()) s->take_package();
+    }
+    for (std::size_t i = 0; i < snap.workers().size(); ++i) {
+        Worker* w = snap.workers()[i];
+        if (ctx.worker_part[i] == me) continue;
+        while (!w->get_queue()->empty()) w->get_queue()->pop();
+        w->clear_processing();
+    }
+
+    std::vector<Delivery> deliveries;
+    for (Time t = 1; t <= ctx.d; ++t) {
+        // 1️⃣ Dostawy (wszystkie rampy -> zgodny rejestr ID)
+        f.do_deliveries(t);
+        for (Ramp* r : foreign_ramps) {
+            if (r->has_package()) r->take_package();
+        }
+
+        // 2️⃣ Przekazywanie: wybór odbiorców, wymiana, dostarczenie
+        deliveries.clear();
+        for (std::size_t i : senders) {
+            PackageSender* s = snap.senders()[i];
+            if (!s->has_package()) continue;
+
+            std::uint32_t k = snap.choose(i);
+            if (k == FactorySnapshot::NO_RECEIVER) continue;
+
+            ReceiverHandle h = snap.successors()[k];
+            std::size_t q = owner(h);
+            if (q == me) {
+                deliveries.push_back(Delivery{static_cast<std::uint32_t>(i), h, s->take_package()});
+            } else {
+                Package p = s->take_package();
+                ex.ring(me, q).push(Transfer{t, static_cast<std::uint32_t>(i), h, p.getID(), p.get_priority(), p.get_deadline()});
+            }
+        }
+
+        ex.wait();
+
+        for (std::size_t q = 0; q < parts; ++q) {
+            if (q == me) continue;
+            Transfer x;
+            while (ex.ring(q, me).pop(t, x)) {
+                deliveries.push_back(Delivery{x.sender, x.receiver, Package::restore(x.package, x.priority, x.deadline)});
+            }
+        }
+
+        // kolejność nadawców jak w jednym procesie
+        std::sort(deliveries.begin(), deliveries.end(),
+            [](const Delivery& a, const Delivery& b) { return a.sender < b.sender; });
+        for (Delivery& x : deliveries) {
+            snap.dispatch(x.receiver, std::move(x.package));
+        }
+
+        // 3️⃣ Praca robotników części
+        f.do_work(t);
+
+        if (is_report_turn(t, ctx.d, ctx.report_every)) {
+            send_state(f, t, out);
+        }
+    }
+}
+
+// =======================================================
+// Proces nadrzędny
+// =======================================================
+
+// Odbiera po jednym checkpoincie od każdej części; false -> któryś proces
+// zamknął potok (poll -> martwy proces nie blokuje odbioru od pozostałych)
+static bool receive_states(const std::vector<int>& fds, std::vector<std::string>& states) {
+    struct Pending {
+        std::string data;
+        std::uint64_t size = 0;
+        bool has_size = false;
+        bool done = false;
+    };
+    std::vector<Pending> pending(fds.size());
+    std::size_t remaining = fds.size();
+    char buf[1 << 16];
+
+    while (remaining > 0) {
+        std::vector<pollfd> pfds;
+        std::vector<std::size_t> who;
+        for (std::size_t k = 0; k < fds.size(); ++k) {
+            if (pending[k].done) continue;
+            pfds.push_back(pollfd{fds[k], POLLIN, 0});
+            who.push_back(k);
+        }
+        if (poll(pfds.data(), pfds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+
+        for (std::size_t j = 0; j < pfds.size(); ++j) {
+            if (!pfds[j].revents) continue;
+            Pending& p = pending[who[j]];
+
+            std::size_t want = p.has_size ? p.size - p.data.size()
+                                          : sizeof p.size - p.data.size();
+            ssize_t k = ::read(pfds[j].fd, buf, std::min(want, sizeof buf));
+            if (k < 0 && errno == EINTR) continue;
+            if (k <= 0) return false;
+            p.data.append(buf, static_cast<std::size_t>(k));
+
+            if (!p.has_size && p.data.size() == sizeof p.size) {
+                std::memcpy(&p.size, p.data.data(), sizeof p.size);
+                p.has_size = true;
+                p.data.clear();
+            }
+            if (p.has_size && p.data.size() == p.size) {
+                states[who[j]] = std::move(p.data);
+                p.done = true;
+                --remaining;
+            }
+        }
+    }
+    return true;
+}
+
+// =======================================================
+// Funkcja simulate_partitioned()
+// =======================================================
+
+void simulate_partitioned(
+    Factory& f,
+    TimeOffset d,
+    std::function<void(Factory&, Time)> rf,
+    const PartitionedOptions& options
+) {
+    if (options.processes == 0) {
+        throw std::invalid_argument("Number of processes must be positive");
+    }
+    if (options.report_every < 0) {
+        throw std::invalid_argument("report_every must not be negative");
+    }
+    if (!f.is_consistent()) {
+        throw std::logic_error("Factory network is not consistent");
+    }
+    for (auto it = f.worker_cbegin(); it != f.worker_cend(); ++it) {
+        if (it->get_queue_capacity() > 0) {
+            // przyjęcie paczki zależy od stanu odbiorcy w innym procesie
+            throw std::logic_error("simulate_partitioned does not support bounded queues");
+        }
+    }
+    if (d <= 0) return;
+
+    const std::size_t parts = options.processes;
+    FactoryPartition partition = partition_factory(f, parts, options.balance);
+
+    PartContext ctx;
+    ctx.parts = parts;
+    ctx.d = d;
+    ctx.report_every = options.report_every;
+    ctx.sender_part = partition.ramps;
+    ctx.sender_part.insert(ctx.sender_part.end(),
+                           partition.workers.begin(), partition.workers.end());
+    ctx.worker_part = partition.workers;
+    ctx.storehouse_part = partition.storehouses;
+
+    // pojemność (p -> q): nadawcy części p, dwie tury (pisarz może być turę dalej)
+    std::vector<std::size_t> owned(parts, 0);
+    for (std::size_t p : ctx.sender_part) ++owned[p];
+    std::vector<std::size_t> capacities(parts * parts);
+    for (std::size_t p = 0; p < parts; ++p) {
+        for (std::size_t q = 0; q < parts; ++q) {
+            capacities[p * parts + q] = (p == q) ? 0 : 2 * owned[p] + 1;
+        }
+    }
+    Exchange exchange(parts, capacities);
+
+    // numer części węzła po ID (składanie checkpointów)
+    std::unordered_map<ElementID, std::size_t> ramp_owner, worker_owner, store_owner;
+    {
+        std::size_t i = 0;
+        for (auto it = f.ramp_cbegin(); it != f.ramp_cend(); ++it) ramp_owner[it->get_id()] = partition.ramps[i++];
+        i = 0;
+        for (auto it = f.worker_cbegin(); it != f.worker_cend(); ++it) worker_owner[it->get_id()] = partition.workers[i++];
+        i = 0;
+        for (auto it = f.storehouse_cbegin(); it != f.storehouse_cend(); ++it) store_owner[it->get_id()] = partition.storehouses[i++];
+    }
+    auto owner = [&](IO::CheckpointNode node, ElementID id) {
+        switch (node) {
+            case IO::CheckpointNode::RAMP: return ramp_owner.at(id);
+            case IO::CheckpointNode::WORKER: return worker_owner.at(id);
+            default: return store_owner.at(id);
+        }
+    };
+
+    // procesy części
+    f.snapshot();
+    std::vector<int> reads;
+    std::vector<int> writes;
+    std::vector<pid_t> children;
+
+    auto stop_children = [&](int sig) {
+        for (pid_t pid : children) {
+            if (sig) kill(pid, sig);
+        }
+        bool ok = true;
+        for (pid_t pid : children) {
+            int status = 0;
+            while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+            ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+        for (int fd : reads) close(fd);
+        children.clear();
+        reads.clear();
+        return ok;
+    };
+
+    for (std::size_t p = 0; p < parts; ++p) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            for (int fd : writes) close(fd);
+            stop_children(SIGKILL);
+            throw std::runtime_error("Cannot create partition pipe");
+        }
+        reads.push_back(fds[0]);
+        writes.push_back(fds[1]);
+    }
+
+    for (std::size_t p = 0; p < parts; ++p) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            for (int fd : writes) close(fd);
+            stop_children(SIGKILL);
+            throw std::runtime_error("Cannot start partition process");
+        }
+        if (pid == 0) {
+            for (int fd : reads) close(fd);
+            for (std::size_t q = 0; q < parts; ++q) {
+                if (q != p) close(writes[q]);
+            }
+            int status = 0;
+            try {
+                ctx.me = p;
+                run_part(f, ctx, exchange, writes[p]);
+            } catch (const std::exception& e) {
+                std::cerr << "partition " << p << ": " << e.what() << '\n';
+                status = 1;
+            }
+            _exit(status);
+        }
+        children.push_back(pid);
+    }
+    for (int fd : writes) close(fd);
+
+    // raporty: stan złożony z checkpointów części
+    std::vector<std::string> states(parts);
+    for (Time t = 1; t <= d; ++t) {
+        if (!is_report_turn(t, d, options.report_every)) continue;
+
+        if (!receive_states(reads, states)) {
+            stop_children(SIGKILL);
+            throw std::runtime_error("Partition process failed");
+        }
+        Time saved = 0;
+        f = IO::merge_checkpoints(states, owner, saved);
+        rf(f, saved);
+    }
+
+    if (!stop_children(0)) {
+        throw std::runtime_error("Partition process failed");
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+// ==============================
+// Partition.hpp
+// ==============================
+// Symulacja podzielona na kilka procesów lokalnych
+//
+// Odpowiada za:
+// - podział grafu fabryki na części (zrównoważone rozmiary,
+//   jak najmniej krawędzi LINK między częściami)
+// - uruchomienie części w osobnych procesach (fork) z wymianą paczek
+//   przez bufory pierścieniowe w pamięci współdzielonej (mmap)
+// - złożenie stanu fabryki z checkpointów części dla raportów
+//
+// Przebieg tury w procesie części p:
+// 1️⃣ do_deliveries(t) na wszystkich rampach (rejestr ID paczek jest
+//    w każdym procesie ten sam), paczki ramp spoza części są odrzucane
+// 2️⃣ nadawcy części losują odbiorców; paczka do obcej części trafia
+//    do pierścienia (p -> q) jako (tura, nadawca, odbiorca, ID paczki)
+//    -> bariera -> paczki własne i przychodzące są dostarczane
+//    w kolejności indeksu nadawcy (jak w Factory::do_package_passing)
+// 3️⃣ do_work(t) robotników części
+//
+// Wynik jest identyczny z simulate() w jednym procesie.
+// Tylko POSIX (fork, mmap, bariera pthread współdzielona między procesami).
+// ==============================
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "Factory/factory.hpp"
+
+// =======================================================
+// Podział grafu
+// =======================================================
+
+struct FactoryPartition {
+    std::size_t parts = 0;
+    // numer części węzła, w kolejności kolekcji fabryki
+    std::vector<std::size_t> ramps;
+    std::vector<std::size_t> workers;
+    std::vector<std::size_t> storehouses;
+    std::size_t cut_links = 0;   // krawędzie LINK między częściami
+};
+
+// balance -> dopuszczalny nadmiar rozmiaru części ponad n / parts
+FactoryPartition partition_factory(const Factory& f, std::size_t parts, double balance = 0.1);
+
+// =======================================================
+// Symulacja wieloprocesowa
+// =======================================================
+
+struct PartitionedOptions {
+    std::size_t processes = 2;
+    double balance = 0.1;
+    TimeOffset report_every = 0;   // 0 -> rf tylko w ostatniej turze
+};
+
+// Jak simulate(f, d, rf), ale rf dostaje złożony stan fabryki tylko co
+// report_every tur oraz w ostatniej turze (zmiany w rf nie wracają
+// do procesów części). Po powrocie f zawiera stan po turze d.
+// Kolejki robotników bez limitu (queue-capacity).
+void simulate_partitioned(
+    Factory& f,
+    TimeOffset d,
+    std::function<void(Factory&, Time)> rf,
+    const PartitionedOptions& options = {}
+);
@@ -0,0 +1,392 @@
+#include "Periodic.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+// =======================================================
+// Odcisk stanu
+// =======================================================
+
+using fingerprint_t = std::vector<std::int64_t>;
+
+// Stan zapamiętany po turze t
+struct StateRecord {
+    Time t;
+    ElementID next_id;                 // następne wolne ID paczki
+    std::vector<std::size_t> stored;   // liczby paczek w magazynach
+    std::vector<DeadlineStats> deadlines;
+    std::vector<WorkerStats> workers;
+    std::vector<long long> blocked;    // tury blokady nadawców (rampy, potem robotnicy)
+    std::vector<long long> lost;       // utracone dostawy ramp
+    fingerprint_t fingerprint;
+};
+
+// Tryb wymaga deterministycznego wyboru odbiorcy, stałych czasów
+// i magazynów SUMMARY. Kolejki z limitem są dozwolone: blokada nadawcy
+// zależy tylko od zapełnienia kolejek odbiorców (w odcisku), a liczniki
+// blokad i odmów są ekstrapolowane w jump()
+static bool is_applicable(const Factory& f) {
+    auto fixed = [](const PackageSender& s) {
+        return s.receiver_preferences.get_probability_generator()
+            .target<FixedProbability>() != nullptr;
+    };
+
+    for (auto it = f.ramp_cbegin(); it != f.ramp_cend(); ++it) {
+        if (!fixed(*it) || !it->has_fixed_schedule()) return false;
+    }
+    for (auto it = f.worker_cbegin(); it != f.worker_cend(); ++it) {
+        if (!fixed(*it) || !it->get_processing_stream().get_distribution().is_fixed()) return false;
+    }
+    for (auto it = f.storehouse_cbegin(); it != f.storehouse_cend(); ++it) {
+        if (it->get_stockpile_type() != StockpileType::SUMMARY) return false;
+    }
+    return true;
+}
+
+static void take_fingerprint(const Factory& f, Time t, fingerprint_t& out) {
+    const ElementID next = Package::next_id();
+    // wiek ID oraz priorytet i termin względem bieżącej tury
+    auto package_state = [&](const Package& p) {
+        out.push_back(next - p.getID());
+        out.push_back(p.get_priority());
+        out.push_back(p.has_deadline() ? 1 : 0);
+        if (p.has_deadline()) {
+            out.push_back(p.get_deadline() - t);
+        }
+    };
+
+    auto sender_state = [&](const PackageSender& s) {
+        out.push_back(s.has_package() ? 1 : 0);
+        if (s.has_package()) {
+            package_state(s.get_package());
+        }
+    };
+
+    out.clear();
+    for (auto it = f.ramp_cbegin(); it != f.ramp_cend(); ++it) {
+        out.push_back(t % it->get_delivery_interval());
+        sender_state(*it);
+    }
+    for (auto it = f.worker_cbegin(); it != f.worker_cend(); ++it) {
+        out.push_back(it->is_processing() ? 1 : 0);
+        if (it->is_processing()) {
+            out.push_back(t - it->get_package_processing_start_time());
+            package_state(it->get_processing_package());
+        }
+        out.push_back(static_cast<std::int64_t>(it->get_in_flight().size()));
+        for (const InFlightPackage& p : it->get_in_flight()) {
+            out.push_back(t - p.start);
+            package_state(p.package);
+        }
+        out.push_back(static_cast<std::int64_t>(it->get_finished().size()));
+        for (const Package& p : it->get_finished()) {
+            package_state(p);
+        }
+        out.push_back(static_cast<std::int64_t>(it->get_queue()->size()));
+        // pełna kolejka z limitem -> nadawcy wybierają innych odbiorców lub czekają
+        if (it->get_queue_capacity() > 0) {
+            out.push_back(it->get_queue()->size() >= it->get_queue_capacity() ? 1 : 0);
+        }
+        for (auto q = it->cbegin(); q != it->cend(); ++q) {
+            package_state(*q);
+        }
+        sender_state(*it);
+    }
+}
+
+// FNV-1a po wartościach odcisku
+static std::uint64_t hash_of(const fingerprint_t& fp) {
+    std::uint64_t h = 1469598103934665603ULL;
+    for (std::int64_t v : fp) {
+        h ^= static_cast<std::uint64_t>(v);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static std::vector<std::size_t> stored_counts(const Factory& f) {
+    std::vector<std::size_t> counts;
+    for (auto it = f.storehouse_cbegin(); it != f.storehouse_cend(); ++it) {
+        counts.push_back(it->get_stockpile()->size());
+    }
+    return counts;
+}
+
+static std::vector<DeadlineStats> deadline_counts(const Factory& f) {
+    std::vector<DeadlineStats> counts;
+    for (auto it = f.storehouse_cbegin(); it != f.storehouse_cend(); ++it) {
+        counts.push_back(it->get_deadline_stats());
+    }
+    return counts;
+}
+
+static std::vector<WorkerStats> worker_counts(const Factory& f) {
+    std::vector<WorkerStats> counts;
+    for (auto it = f.worker_cbegin(); it != f.worker_cend(); ++it) {
+        counts.push_back(it->get_stats());
+    }
+    return counts;
+}
+
+static std::vector<long long> blocked_counts(const Factory& f) {
+    std::vector<long long> counts;
+    for (auto it = f.ramp_cbegin(); it != f.ramp_cend(); ++it) {
+        counts.push_back(it->get_blocked_turns());
+    }
+    for (auto it = f.worker_cbegin(); it != f.worker_cend(); ++it) {
+        counts.push_back(it->get_blocked_turns());
+    }
+    return counts;
+}
+
+static std::vector<long long> lost_counts(const Factory& f) {
+    std::vector<long long> counts;
+    for (auto it = f.ramp_cbegin(); it != f.ramp_cend(); ++it) {
+        counts.push_back(it->get_lost_deliveries());
+    }
+    return counts;
+}
+
+static StateRecord record_state(const Factory& f, Time t, const fingerprint_t& fp) {
+    return StateRecord{t, Package::next_id(), stored_counts(f), deadline_counts(f),
+                       worker_counts(f), blocked_counts(f), lost_counts(f), fp};
+}
+
+// =======================================================
+// Przeskok o k okresów
+// =======================================================
+
+// Przyrosty liczników w k okresach po okresie (r.t, t]
+struct PeriodGrowth {
+    std::vector<std::size_t> added;
+    std::vector<DeadlineStats> late;
+    std::vector<WorkerStats> workers;
+    std::vector<long long> blocked;
+    std::vector<long long> lost;
+};
+
+static PeriodGrowth period_growth(const Factory& f, const StateRecord& r, TimeOffset period, TimeOffset k) {
+    const StateRecord now = record_state(f, r.t + period, {});
+    const std::size_t kk = static_cast<std::size_t>(k);
+    PeriodGrowth g;
+
+    for (std::size_t i = 0; i < now.stored.size(); ++i) {
+        g.added.push_back(kk * (now.stored[i] - r.stored[i]));
+    }
+
+    for (std::size_t i = 0; i < now.deadlines.size(); ++i) {
+        DeadlineStats ds;
+        ds.due = kk * (now.deadlines[i].due - r.deadlines[i].due);
+        ds.late = kk * (now.deadlines[i].late - r.deadlines[i].late);
+        ds.tardiness_sum = k * (now.deadlines[i].tardiness_sum - r.deadlines[i].tardiness_sum);
+        g.late.push_back(ds);
+    }
+
+    // sumy tur przybycia / odejścia: w okresie j po (r.t, t] te same
+    // zdarzenia j * period tur później -> k * przyrost + period * n * k(k+1)/2
+    const long long shift = static_cast<long long>(period) * k * (k + 1) / 2;
+    for (std::size_t i = 0; i < now.workers.size(); ++i) {
+        const WorkerStats& a = r.workers[i];
+        const WorkerStats& b = now.workers[i];
+        WorkerStats ws;
+        ws.received = kk * (b.received - a.received);
+        ws.rejected = kk * (b.rejected - a.rejected);
+        ws.processed = kk * (b.processed - a.processed);
+        ws.busy_turns = k * (b.busy_turns - a.busy_turns);
+        ws.arrival_time_sum = k * (b.arrival_time_sum - a.arrival_time_sum) +
+            shift * static_cast<long long>(b.received - a.received);
+        ws.departure_time_sum = k * (b.departure_time_sum - a.departure_time_sum) +
+            shift * static_cast<long long>(b.processed - a.processed);
+        g.workers.push_back(ws);
+    }
+
+    for (std::size_t i = 0; i < now.blocked.size(); ++i) {
+        g.blocked.push_back(k * (now.blocked[i] - r.blocked[i]));
+    }
+    for (std::size_t i = 0; i < now.lost.size(); ++i) {
+        g.lost.push_back(k * (now.lost[i] - r.lost[i]));
+    }
+    return g;
+}
+
+// Ta sama paczka k okresów później: ID i termin przesunięte
+static Package shifted(const Package& p, ElementID did, TimeOffset dt) {
+    return Package::restore(
+        p.getID() + did,
+        p.get_priority(),
+        p.has_deadline() ? p.get_deadline() + dt : Package::NO_DEADLINE);
+}
+
+static void shift_buffer(PackageSender& sender, ElementID did, TimeOffset dt) {
+    if (sender.has_package()) {
+        Package p = sender.take_package();
+        sender.push_package(shifted(p, did, dt));
+    }
+}
+
+static void jump(
+    Factory& f,
+    TimeOffset dt,
+    ElementID did,
+    const PeriodGrowth& g,
+    Time from,
+    Time to
+) {
+    std::size_t sender = 0;
+    std::size_t r = 0;
+    for (auto it = f.ramp_begin(); it != f.ramp_end(); ++it, ++r, ++sender) {
+        shift_buffer(*it, did, dt);
+        it->restore_blocked_turns(it->get_blocked_turns() + g.blocked[sender]);
+        it->restore_lost_deliveries(it->get_lost_deliveries() + g.lost[r]);
+    }
+
+    std::size_t w = 0;
+    for (auto it = f.worker_begin(); it != f.worker_end(); ++it, ++w, ++sender) {
+        // kolejka: te same pozycje, ID i terminy przesunięte
+        std::vector<Package> queued;
+        for (auto q = it->cbegin(); q != it->cend(); ++q) {
+            queued.push_back(shifted(*q, did, dt));
+        }
+        IPackageQueue* queue = it->get_queue();
+        for (std::size_t i = 0; i < queued.size(); ++i) {
+            queue->pop();
+        }
+        for (Package& p : queued) {
+            queue->push(std::move(p));
+        }
+
+        if (it->is_processing()) {
+            Time start = it->get_package_processing_start_time();
+            it->restore_processing(shifted(it->get_processing_package(), did, dt), start + dt,
+                                   it->get_processing_duration());
+        }
+
+        if (it->is_multi_server()) {
+            std::vector<InFlightPackage> in_flight;
+            for (const InFlightPackage& p : it->get_in_flight()) {
+                in_flight.push_back(InFlightPackage{shifted(p.package, did, dt), p.start + dt, p.duration});
+            }
+            std::vector<Package> finished;
+            for (const Package& p : it->get_finished()) {
+                finished.push_back(shifted(p, did, dt));
+            }
+            it->clear_processing();
+            for (InFlightPackage& p : in_flight) {
+                it->restore_in_flight(std::move(p.package), p.start, p.duration);
+            }
+            for (Package& p : finished) {
+                it->restore_finished(std::move(p));
+            }
+        }
+        shift_buffer(*it, did, dt);
+        it->restore_blocked_turns(it->get_blocked_turns() + g.blocked[sender]);
+
+        WorkerStats ws = it->get_stats();
+        ws.received += g.workers[w].received;
+        ws.rejected += g.workers[w].rejected;
+        ws.processed += g.workers[w].processed;
+        ws.busy_turns += g.workers[w].busy_turns;
+        ws.arrival_time_sum += g.workers[w].arrival_time_sum;
+        ws.departure_time_sum += g.workers[w].departure_time_sum;
+        it->restore_stats(ws);
+    }
+
+    std::size_t i = 0;
+    for (auto it = f.storehouse_begin(); it != f.storehouse_end(); ++it, ++i) {
+        static_cast<PackageSummary*>(it->get_stockpile())->add_bulk(g.added[i], from, to);
+
+        // spóźnienia rosną o przyrosty z okresu, maksimum już osiągnięte
+        DeadlineStats ds = it->get_deadline_stats();
+        ds.due += g.late[i].due;
+        ds.late += g.late[i].late;
+        ds.tardiness_sum += g.late[i].tardiness_sum;
+        it->restore_deadline_stats(ds);
+    }
+
+    Package::skip_ids(did);
+}
+
+// =======================================================
+// Funkcja simulate_periodic()
+// =======================================================
+
+PeriodicRunInfo simulate_periodic(
+    Factory& f,
+    TimeOffset d,
+    std::function<void(Factory&, Time)> rf,
+    std::size_t max_history
+) {
+    if (!f.is_consistent()) {
+        throw std::logic_error("Factory network is not consistent");
+    }
+
+    PeriodicRunInfo info;
+    bool detecting = is_applicable(f);
+
+    std::unordered_multimap<std::uint64_t, std::size_t> seen;
+    std::vector<StateRecord> history;
+    std::size_t history_size = 0; // łączna liczba zapamiętanych wartości
+    fingerprint_t fp;
+
+    for (Time t = 1; t <= d; ++t) {
+        f.do_deliveries(t);
+        f.do_package_passing();
+        f.do_work(t);
+        rf(f, t);
+        ++info.turns_simulated;
+
+        if (!detecting) continue;
+
+        take_fingerprint(f, t, fp);
+        std::uint64_t h = hash_of(fp);
+
+        auto range = seen.equal_range(h);
+        for (auto it = range.first; it != range.second; ++it) {
+            const StateRecord& r = history[it->second];
+            if (r.fingerprint != fp) continue;
+
+            // cykl: stan po turze t == stan po turze r.t
+            info.cycle_start = r.t;
+            info.period = t - r.t;
+            detecting = false;
+
+            TimeOffset k = (d - t) / info.period;
+            if (k == 0) break;
+
+            long long did = static_cast<long long>(k) * (Package::next_id() - r.next_id);
+            // po skoku ID paczek w buforach i kolejne nadawane sięgają next_id() + did
+            if (static_cast<long long>(Package::next_id()) + did > std::numeric_limits<ElementID>::max()) {
+                throw std::overflow_error("Package IDs exceed ElementID range");
+            }
+
+            const PeriodGrowth growth = period_growth(f, r, info.period, k);
+
+            TimeOffset dt = k * info.period;
+            jump(f, dt, static_cast<ElementID>(did), growth, t + 1, t + dt);
+
+            info.extrapolated = true;
+            info.jump_from = t;
+            info.jump_to = t + dt;
+            t += dt;
+            break;
+        }
+
+        if (!detecting) {
+            seen.clear();
+            history.clear();
+        } else if (history_size + fp.size() > max_history) {
+            detecting = false;
+            seen.clear();
+            history.clear();
+        } else {
+            seen.emplace(h, history.size());
+            history_size += fp.size();
+            history.push_back(record_state(f, t, fp));
+        }
+    }
+
+    return info;
+}
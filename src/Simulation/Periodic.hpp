@@ -0,0 +1,62 @@
+#pragma once
+
+// ==============================
+// Periodic.hpp
+// ==============================
+// Wykrywanie okresowości stanu i ekstrapolacja do horyzontu
+//
+// Przy deterministycznym wyborze odbiorcy (FixedProbability) i stałych
+// czasach pracy stan fabryki po okresie przejściowym powtarza się.
+// Po każdej turze liczony jest kanoniczny odcisk stanu:
+// - fazy ramp (t mod interval) i bufory nadawców
+// - kolejki (z limitem: czy pełna -> blokada nadawców), paczki w obróbce,
+//   czas od rozpoczęcia pracy
+// - ID paczek względem następnego wolnego ID (wiek paczki)
+// Magazyny nie wchodzą do odcisku (tylko rosną).
+//
+// Po wykryciu cyklu o okresie p symulacja przeskakuje k pełnych okresów:
+// liczniki magazynów, robotników (WorkerStats), blokad nadawców i utraconych
+// dostaw rosną o k * przyrost na okres, ID paczek w obiegu
+// i alokator ID przesuwają się o k * liczba paczek na okres.
+//
+// Tryb działa tylko gdy wszystkie magazyny są w trybie SUMMARY,
+// wszyscy nadawcy mają generator stały, a czasy obróbki i odstępy
+// dostaw są stałe; w przeciwnym razie
+// symulacja przebiega zwykłym trybem. Po przeskoku próbka ID magazynu
+// pochodzi sprzed przeskoku, a histogram rozkłada przyrost równomiernie.
+// ==============================
+
+#include <cstddef>
+#include <functional>
+
+#include "Factory/factory.hpp"
+
+// =======================================================
+// Wynik przebiegu
+// =======================================================
+
+struct PeriodicRunInfo {
+    bool extrapolated = false;   // czy wykonano przeskok
+    Time cycle_start = 0;        // tura, od której stan się powtarza
+    TimeOffset period = 0;       // długość okresu
+    Time jump_from = 0;          // przeskok: z tury...
+    Time jump_to = 0;            // ...do tury
+    TimeOffset turns_simulated = 0;
+};
+
+// =======================================================
+// Symulacja z wykrywaniem okresowości
+// =======================================================
+//
+// max_history -> budżet pamięci odcisków (łączna liczba zapamiętanych wartości);
+//                po przekroczeniu wykrywanie jest wyłączane (np. rosnące kolejki),
+//                a symulacja trwa dalej zwykłym trybem
+//
+// rf jest wywoływana tylko w turach faktycznie symulowanych.
+//
+PeriodicRunInfo simulate_periodic(
+    Factory& f,
+    TimeOffset d,
+    std::function<void(Factory&, Time)> rf,
+    std::size_t max_history = 1 << 22
+);
@@ -1,4 +1,17 @@
 #include "Simulation.hpp"
+#include "WorkerLayout.hpp"
+#include "DispatchCore.hpp"
+#include "ChainCompression.hpp"
+#include "Partition.hpp"
+#include "Factory/Affinity.hpp"
+#include "io/Parser.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory_resource>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
 
 // =======================================================
 // Funkcja simulate()
@@ -8,25 +21,259 @@ void simulate(
     Factory& f,
     TimeOffset d,
     std::function<void(Factory&, Time)> rf
+) {
+    simulate(f, d, rf, ExecutionLayout::NODES);
+}
+
+// Tury first..last w wybranym układzie wykonania
+static void run_turns(
+    Factory& f,
+    Time first,
+    Time last,
+    std::function<void(Factory&, Time)>& rf,
+    ExecutionLayout layout,
+    TimeOffset report_every = 1
 ) {
     // Sprawdzenie spójności sieci przed startem
     if (!f.is_consistent()) {
         throw std::logic_error("Factory network is not consistent");
     }
 
+    // Układy kompilowane raz na przebieg (topologia się nie zmienia)
+    std::unique_ptr<WorkerLayout> soa;
+    if (layout == ExecutionLayout::SOA) {
+        soa.reset(new WorkerLayout(f));
+    }
+    std::unique_ptr<DispatchCore> core;
+    if (layout == ExecutionLayout::HANDLES) {
+        core.reset(new DispatchCore(f));
+    }
+    std::unique_ptr<ChainCompressor> chains;
+    if (layout == ExecutionLayout::CHAINS) {
+        chains.reset(new ChainCompressor(f));
+        chains->collapse(first - 1);
+    }
+
     // Pętla czasowa symulacji
-    for (Time t = 1; t <= d; ++t) {
+    for (Time t = first; t <= last; ++t) {
 
         // 1️⃣ Dostawy na rampy
         f.do_deliveries(t);
 
         // 2️⃣ Przekazywanie paczek (nadawcy -> odbiorcy)
-        f.do_package_passing();
+        if (core) {
+            core->do_package_passing();
+        } else {
+            f.do_package_passing();
+        }
 
         // 3️⃣ Praca robotników
-        f.do_work(t);
+        if (soa) {
+            soa->do_work(t);
+        } else if (chains) {
+            chains->do_work(t);
+        } else {
+            f.do_work(t);
+        }
 
         // 4️⃣ Raportowanie (jeśli strategia tak zdecyduje)
+        if (!chains) {
+            rf(f, t);
+        } else if (t == last || (t - first + 1) % report_every == 0) {
+            // raport widzi pełny stan robotników łańcuchów
+            chains->expand(t);
+            rf(f, t);
+            if (t != last) chains->collapse(t);
+        }
+    }
+
+    if (chains && chains->is_collapsed()) {
+        chains->expand(last);
+    }
+}
+
+void simulate(
+    Factory& f,
+    TimeOffset d,
+    std::function<void(Factory&, Time)> rf,
+    ExecutionLayout layout
+) {
+    run_turns(f, 1, d, rf, layout);
+}
+
+// =======================================================
+// Funkcja simulate_range()
+// =======================================================
+
+void simulate_range(
+    Factory& f,
+    Time first,
+    Time last,
+    std::function<void(Factory&, Time)> rf
+) {
+    run_turns(f, first, last, rf, ExecutionLayout::NODES);
+}
+
+// =======================================================
+// Funkcja simulate_event_driven()
+// =======================================================
+
+void simulate_event_driven(
+    Factory& f,
+    TimeOffset d,
+    std::function<void(Factory&, Time)> rf
+) {
+    if (!f.is_consistent()) {
+        throw std::logic_error("Factory network is not consistent");
+    }
+
+    for (Time t = f.next_event_time(0); t <= d; t = f.next_event_time(t)) {
+        f.do_deliveries(t);
+        f.do_package_passing();
+        f.do_work(t);
+        rf(f, t);
+    }
+}
+
+// =======================================================
+// Funkcja simulate_compressed()
+// =======================================================
+
+void simulate_compressed(
+    Factory& f,
+    TimeOffset d,
+    std::function<void(Factory&, Time)> rf,
+    TimeOffset report_every
+) {
+    if (report_every <= 0) {
+        throw std::invalid_argument("report_every must be positive");
+    }
+    run_turns(f, 1, d, rf, ExecutionLayout::CHAINS, report_every);
+}
+
+// =======================================================
+// Funkcja simulate_parallel()
+// =======================================================
+
+// Kolejki robotników i magazynów w arenach węzłów NUMA wątków ich części
+// na czas simulate_parallel(); destruktor oddaje kolejki poprzedniemu
+// zasobowi (także przy wyjątku z tury)
+struct NumaPlacement {
+    std::vector<std::unique_ptr<NodeLocalArena>> arenas;   // na wątek puli
+    std::vector<PackageQueue*> queues;
+    std::pmr::memory_resource* previous = std::pmr::get_default_resource();
+
+    NumaPlacement(Factory& f,
+                  const NumaTopology& topology,
+                  const std::vector<ThreadPlacement>& threads,
+                  const FactoryPartition& partition,
+                  std::size_t arena_size) {
+        for (const ThreadPlacement& p : threads) {
+            arenas.emplace_back(new NodeLocalArena(arena_size, topology.nodes[p.node]));
+        }
+
+        const FactorySnapshot& snap = f.snapshot();
+        const std::size_t n = threads.size();
+
+        // część robotnika jak w Factory::do_work(t, pool, home)
+        for (std::size_t i = 0; i < snap.workers().size(); ++i) {
+            std::size_t part = partition.workers.empty()
+                ? i * n / snap.workers().size()
+                : partition.workers[i] % n;
+            move(dynamic_cast<PackageQueue*>(snap.workers()[i]->get_queue()), part);
+        }
+        for (std::size_t i = 0; i < snap.storehouses().size(); ++i) {
+            std::size_t part = partition.storehouses.empty() ? 0 : partition.storehouses[i] % n;
+            move(dynamic_cast<PackageQueue*>(snap.storehouses()[i]->get_stockpile()), part);
+        }
+    }
+
+    ~NumaPlacement() {
+        for (PackageQueue* q : queues) {
+            q->set_resource(previous);
+        }
+    }
+
+    // kolejki innych typów (np. magazyn SUMMARY) zostają na miejscu
+    void move(PackageQueue* q, std::size_t part) {
+        if (!q) return;
+        q->set_resource(arenas[part]->resource());
+        queues.push_back(q);
+    }
+};
+
+std::vector<StealStats> simulate_parallel(
+    Factory& f,
+    TimeOffset d,
+    std::function<void(Factory&, Time)> rf,
+    const ParallelOptions& options
+) {
+    if (!f.is_consistent()) {
+        throw std::logic_error("Factory network is not consistent");
+    }
+
+    unsigned threads = options.threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // jeden węzeł NUMA -> bez przypięcia i przenoszenia kolejek
+    NumaTopology topology;
+    std::vector<ThreadPlacement> placement;
+    std::vector<int> cpus;
+    if (options.numa) {
+        topology = detect_numa_topology();
+        if (topology.is_numa()) {
+            placement = place_threads(topology, threads);
+            for (const ThreadPlacement& p : placement) {
+                cpus.push_back(p.cpu);
+            }
+        }
+    }
+
+    WorkStealingPool pool(threads, cpus);
+    FactoryPartition partition;
+    if (options.partition && pool.size() > 1) {
+        partition = partition_factory(f, pool.size());
+    }
+
+    std::unique_ptr<NumaPlacement> memory;
+    if (!placement.empty()) {
+        memory.reset(new NumaPlacement(f, topology, placement, partition, options.numa_arena_size));
+    }
+
+    for (Time t = 1; t <= d; ++t) {
+        f.do_deliveries(t);
+        f.do_package_passing(pool);
+        f.do_work(t, pool, partition.workers);
         rf(f, t);
     }
+    return pool.stats();
+}
+
+// =======================================================
+// Benchmark NUMA
+// =======================================================
+
+NumaBenchmark benchmark_numa(const std::string& topology, TimeOffset d, unsigned threads) {
+    auto run = [&](bool numa) {
+        std::istringstream is(topology);
+        Factory f = IO::load_factory_structure(is);
+
+        ParallelOptions options;
+        options.threads = threads;
+        options.numa = numa;
+
+        auto start = std::chrono::steady_clock::now();
+        simulate_parallel(f, d, [](Factory&, Time) {}, options);
+        auto stop = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::milli>(stop - start).count();
+    };
+
+    NumaBenchmark result;
+    result.nodes = detect_numa_topology().nodes.size();
+    result.unpinned_ms = run(false);
+    result.pinned_ms = run(true);
+    return result;
 }
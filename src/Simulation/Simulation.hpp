@@ -13,7 +13,10 @@
 // Zgodne z PDF „Symulacja”
 // ==============================
 
+#include <cstddef>
 #include <functional>
+#include <string>
+#include <vector>
 
 #include "Factory/factory.hpp"
 
@@ -32,3 +35,109 @@ void simulate(
     TimeOffset d,
     std::function<void(Factory&, Time)> rf
 );
+
+// =======================================================
+// Wariant z wybranym układem wykonania
+// =======================================================
+//
+// NODES   -> Factory::do_package_passing / Factory::do_work
+// SOA     -> WorkerLayout (stan czasowy w tablicach, test końca pracy SIMD)
+// HANDLES -> DispatchCore (wszyscy nadawcy po kolei na obrazie CSR, bez zbiorów aktywnych)
+// CHAINS  -> ChainCompressor (łańcuchy robotników FIFO jako węzły złożone;
+//            przed każdym rf stan łańcuchów jest rozwijany do robotników)
+//
+// Wszystkie układy dają identyczny przebieg symulacji.
+//
+enum class ExecutionLayout { NODES, SOA, HANDLES, CHAINS };
+
+void simulate(
+    Factory& f,
+    TimeOffset d,
+    std::function<void(Factory&, Time)> rf,
+    ExecutionLayout layout
+);
+
+// =======================================================
+// Symulacja wybranego zakresu tur
+// =======================================================
+//
+// Tury first..last (włącznie), np. kontynuacja od t + 1 po odtworzeniu
+// checkpointu zapisanego w turze t (IO::save_checkpoint w rf).
+//
+void simulate_range(
+    Factory& f,
+    Time first,
+    Time last,
+    std::function<void(Factory&, Time)> rf
+);
+
+// =======================================================
+// Symulacja sterowana zdarzeniami
+// =======================================================
+//
+// Ten sam przebieg co simulate(), ale tury, w których nic się nie dzieje
+// (Factory::next_event_time), są pomijane. Dostawy wyzwala koło czasowe.
+// rf jest wywoływana tylko w turach, które zostały wykonane.
+//
+void simulate_event_driven(
+    Factory& f,
+    TimeOffset d,
+    std::function<void(Factory&, Time)> rf
+);
+
+// =======================================================
+// Symulacja ze skompresowanymi łańcuchami
+// =======================================================
+//
+// Jak simulate(..., ExecutionLayout::CHAINS), ale stan łańcuchów jest
+// rozwijany do robotników (i rf wywoływana) tylko co report_every tur
+// oraz w ostatniej turze. Po powrocie fabryka jest w stanie rozwiniętym.
+//
+void simulate_compressed(
+    Factory& f,
+    TimeOffset d,
+    std::function<void(Factory&, Time)> rf,
+    TimeOffset report_every
+);
+
+// =======================================================
+// Symulacja z równoległymi fazami tury
+// =======================================================
+//
+// Jak simulate(), ale przekazywanie paczek (skrzynki PackageInbox)
+// i praca robotników działają na puli wątków z podkradaniem zadań
+// (WorkStealingPool). Zadania pracy są grupowane wg części grafu
+// (partition_factory na liczbę wątków) i aktywności.
+// Zwraca liczniki wątków puli (kradzieże, czas bezczynności).
+//
+// numa: wątki przypięte do rdzeni (kolejne bloki wątków na kolejnych
+// węzłach NUMA), a kolejki robotników i magazynów części przeniesione
+// do areny węzła wątku tej części (NodeLocalArena). Po przebiegu kolejki
+// wracają do domyślnego zasobu. Na maszynie z jednym węzłem -> no-op.
+//
+struct ParallelOptions {
+    unsigned threads = 0;        // 0 -> std::thread::hardware_concurrency()
+    bool partition = true;       // false -> bloki indeksów robotników
+    bool numa = false;
+    std::size_t numa_arena_size = 1 << 22;   // bufor początkowy areny węzła na część
+};
+
+std::vector<StealStats> simulate_parallel(
+    Factory& f,
+    TimeOffset d,
+    std::function<void(Factory&, Time)> rf,
+    const ParallelOptions& options = {}
+);
+
+// =======================================================
+// Benchmark: przypięcie NUMA vs bez przypięcia
+// =======================================================
+
+struct NumaBenchmark {
+    std::size_t nodes;     // węzły NUMA maszyny
+    double unpinned_ms;    // simulate_parallel, numa = false
+    double pinned_ms;      // simulate_parallel, numa = true
+};
+
+// Wczytuje topologię dwa razy i mierzy d tur każdym wariantem
+NumaBenchmark benchmark_numa(const std::string& topology, TimeOffset d, unsigned threads);
@@ -0,0 +1,80 @@
+#include "Statistics.hpp"
+
+#include <cmath>
+
+// =======================================================
+// Kwantyle
+// =======================================================
+
+// Acklam, błąd względny < 1.2e-9
+double normal_quantile(double p) {
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02,
+                               -2.759285104469687e+02, 1.383577518672690e+02,
+                               -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02,
+                               -1.556989798598866e+02, 6.680131188771972e+01,
+                               -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01,
+                               -2.400758277161838e+00, -2.549732539343734e+00,
+                               4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01,
+                               2.445134137142996e+00, 3.754408661907416e+00};
+
+    const double low = 0.02425;
+    if (p < low) {
+        double q = std::sqrt(-2 * std::log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    }
+    if (p > 1 - low) {
+        return -normal_quantile(1 - p);
+    }
+    double q = p - 0.5;
+    double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+}
+
+// Rozwinięcie Cornisha-Fishera wokół kwantyla normalnego
+double student_quantile(double p, double df) {
+    double z = normal_quantile(p);
+    double z3 = z * z * z;
+    double z5 = z3 * z * z;
+    double z7 = z5 * z * z;
+    return z
+        + (z3 + z) / (4 * df)
+        + (5 * z5 + 16 * z3 + 3 * z) / (96 * df * df)
+        + (3 * z7 + 19 * z5 + 17 * z3 - 15 * z) / (384 * df * df * df);
+}
+
+// =======================================================
+// Średnia z przedziałem ufności
+// =======================================================
+
+MeanEstimate estimate_mean(
+    const std::vector<double>& y,
+    double confidence,
+    std::size_t first
+) {
+    MeanEstimate e;
+    if (first >= y.size()) return e;
+    const std::size_t k = y.size() - first;
+
+    double sum = 0.0;
+    for (std::size_t i = first; i < y.size(); ++i) sum += y[i];
+    e.mean = sum / k;
+
+    if (k < 2) {
+        e.half_width = INFINITY;
+        return e;
+    }
+
+    double ss = 0.0;
+    for (std::size_t i = first; i < y.size(); ++i) {
+        ss += (y[i] - e.mean) * (y[i] - e.mean);
+    }
+    e.variance = ss / (k - 1);
+    double tq = student_quantile(0.5 + confidence / 2, static_cast<double>(k - 1));
+    e.half_width = tq * std::sqrt(e.variance / k);
+    return e;
+}
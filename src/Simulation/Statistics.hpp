@@ -0,0 +1,38 @@
+#pragma once
+
+// ==============================
+// Statistics.hpp
+// ==============================
+// Statystyka wyników symulacji
+//
+// Odpowiada za:
+// - kwantyle rozkładu normalnego i t-Studenta
+// - średnią z przedziałem ufności (t-Student)
+// ==============================
+
+#include <cstddef>
+#include <vector>
+
+// =======================================================
+// Estymacja średniej
+// =======================================================
+
+struct MeanEstimate {
+    double mean = 0.0;         // średnia
+    double half_width = 0.0;   // połowa szerokości przedziału ufności
+    double variance = 0.0;     // wariancja próbki (n - 1)
+};
+
+// Odwrotna dystrybuanta N(0, 1)
+double normal_quantile(double p);
+
+// Kwantyl rozkładu t-Studenta o df stopniach swobody
+double student_quantile(double p, double df);
+
+// Średnia y[first..] z przedziałem ufności na poziomie confidence
+// (mniej niż 2 obserwacje -> half_width = inf)
+MeanEstimate estimate_mean(
+    const std::vector<double>& y,
+    double confidence,
+    std::size_t first = 0
+);
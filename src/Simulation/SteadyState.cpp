@@ -0,0 +1,142 @@
+#include "SteadyState.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+// =======================================================
+// Seria średnich partii
+// =======================================================
+//
+// Sumy prefiksowe dopisywane w O(1) na partię: sumy sufiksowe dla
+// dowolnego punktu odcięcia d to sum[n] - sum[d] (bez przeliczania serii).
+
+struct BatchSeries {
+    std::vector<double> y;
+    std::vector<double> sum{0.0}, sum2{0.0};   // sum[i] = y[0] + ... + y[i - 1]
+
+    void push(double v) {
+        y.push_back(v);
+        sum.push_back(sum.back() + v);
+        sum2.push_back(sum2.back() + v * v);
+    }
+
+    // suma kwadratów odchyleń y[d..] od ich średniej
+    double deviation(std::size_t d) const {
+        const std::size_t n = y.size();
+        double k = static_cast<double>(n - d);
+        double s = sum[n] - sum[d];
+        return (sum2[n] - sum2[d]) - s * s / k;
+    }
+
+    // MSER: punkt odcięcia d minimalizujący sumę kwadratów odchyleń / (n - d)^2
+    // (szukany w pierwszej połowie serii)
+    std::size_t mser_truncation() const {
+        const std::size_t n = y.size();
+        if (n < 2) return 0;
+
+        std::size_t best = 0;
+        double best_value = INFINITY;
+        for (std::size_t d = 0; d <= n / 2; ++d) {
+            double k = static_cast<double>(n - d);
+            double value = deviation(d) / (k * k);
+            if (value < best_value) {
+                best_value = value;
+                best = d;
+            }
+        }
+        return best;
+    }
+
+    // czy przedział ufności średniej y[first..] mieści się w tolerancji
+    // (jak estimate_mean, ale z sum prefiksowych)
+    bool within_tolerance(std::size_t first, double confidence, double tolerance) const {
+        const std::size_t k = y.size() - first;
+        if (k < 2) return false;
+        double mean = (sum[y.size()] - sum[first]) / k;
+        double variance = std::max(deviation(first), 0.0) / (k - 1);
+        double tq = student_quantile(0.5 + confidence / 2, static_cast<double>(k - 1));
+        return tq * std::sqrt(variance / k) <= tolerance * std::fabs(mean);
+    }
+};
+
+// =======================================================
+// Funkcja simulate_until_steady()
+// =======================================================
+
+SteadyStateResult simulate_until_steady(
+    Factory& f,
+    const SteadyStateOptions& options,
+    std::function<void(Factory&, Time)> rf
+) {
+    if (options.batch_size <= 0 || options.min_batches < 2 ||
+        options.confidence <= 0.0 || options.confidence >= 1.0) {
+        throw std::invalid_argument("Invalid steady-state options");
+    }
+    if (!f.is_consistent()) {
+        throw std::logic_error("Factory network is not consistent");
+    }
+
+    auto stored = [&f]() {
+        std::size_t n = 0;
+        for (auto it = f.storehouse_cbegin(); it != f.storehouse_cend(); ++it) {
+            n += it->get_stockpile()->size();
+        }
+        return n;
+    };
+    auto queued = [&f]() {
+        std::size_t n = 0;
+        for (auto it = f.worker_cbegin(); it != f.worker_cend(); ++it) {
+            n += it->get_queue()->size();
+        }
+        return n;
+    };
+
+    SteadyStateResult result;
+    BatchSeries throughput, queue_length; // średnie partii
+    std::size_t cut = 0;
+    bool estimated = false;               // czy po rozbiegu jest min_batches partii
+
+    std::size_t last_stored = stored();
+    double batch_queue = 0.0;
+
+    for (Time t = 1; t <= options.max_turns; ++t) {
+        f.do_deliveries(t);
+        f.do_package_passing();
+        f.do_work(t);
+        rf(f, t);
+
+        result.turns = t;
+        batch_queue += static_cast<double>(queued());
+
+        if (t % options.batch_size != 0) continue;
+
+        // koniec partii
+        std::size_t now_stored = stored();
+        throughput.push(static_cast<double>(now_stored - last_stored) / options.batch_size);
+        queue_length.push(batch_queue / options.batch_size);
+        last_stored = now_stored;
+        batch_queue = 0.0;
+
+        // rozbieg: późniejszy z punktów odcięcia obu serii
+        std::size_t batch_cut = std::max(throughput.mser_truncation(), queue_length.mser_truncation());
+        if (throughput.y.size() - batch_cut < options.min_batches) continue;
+
+        cut = batch_cut;
+        estimated = true;
+        if (throughput.within_tolerance(cut, options.confidence, options.relative_tolerance)) {
+            result.converged = true;
+            break;
+        }
+    }
+
+    // estymatory raz, dla ostatniego punktu odcięcia
+    if (estimated) {
+        result.warmup_turns = static_cast<TimeOffset>(cut) * options.batch_size;
+        result.batches = throughput.y.size() - cut;
+        result.throughput = estimate_mean(throughput.y, options.confidence, cut);
+        result.queue_length = estimate_mean(queue_length.y, options.confidence, cut);
+    }
+    return result;
+}
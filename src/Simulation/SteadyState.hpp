@@ -0,0 +1,56 @@
+#pragma once
+
+// ==============================
+// SteadyState.hpp
+// ==============================
+// Symulacja do osiągnięcia stanu ustalonego
+//
+// Odpowiada za:
+// - zbieranie średnich w partiach (batch means) przepustowości
+//   (paczki przyjęte przez magazyny na turę) i długości kolejek
+// - wyznaczenie końca rozbiegu (MSER na średnich partii)
+// - zatrzymanie symulacji, gdy połowa szerokości przedziału ufności
+//   przepustowości spadnie poniżej zadanej tolerancji
+// ==============================
+
+#include <cstddef>
+#include <functional>
+
+#include "Factory/factory.hpp"
+#include "Simulation/Statistics.hpp"
+
+// =======================================================
+// Parametry i wynik
+// =======================================================
+
+struct SteadyStateOptions {
+    TimeOffset batch_size = 100;       // tur na partię
+    std::size_t min_batches = 10;      // minimum partii po rozbiegu
+    double confidence = 0.95;          // poziom ufności
+    double relative_tolerance = 0.05;  // połowa szerokości / średnia
+    TimeOffset max_turns = 1000000;    // limit tur (brak zbieżności)
+};
+
+// średnia po rozbiegu z połową szerokości przedziału ufności
+using SteadyStateEstimate = MeanEstimate;
+
+struct SteadyStateResult {
+    bool converged = false;            // czy osiągnięto tolerancję
+    TimeOffset turns = 0;              // tury faktycznie zasymulowane
+    TimeOffset warmup_turns = 0;       // odcięty rozbieg
+    std::size_t batches = 0;           // partie użyte do estymacji
+    SteadyStateEstimate throughput;    // paczki do magazynów na turę
+    SteadyStateEstimate queue_length;  // łączna długość kolejek robotników
+};
+
+// =======================================================
+// Funkcja simulate_until_steady()
+// =======================================================
+//
+// rf -> raportowanie jak w simulate() (wywoływana w każdej turze)
+//
+SteadyStateResult simulate_until_steady(
+    Factory& f,
+    const SteadyStateOptions& options,
+    std::function<void(Factory&, Time)> rf
+);
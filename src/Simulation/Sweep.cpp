@@ -0,0 +1,259 @@
+#include "Sweep.hpp"
+#include "Simulation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+// =======================================================
+// Osie przeglądu
+// =======================================================
+
+static const char* parameter_name(SweepParameter p) {
+    switch (p) {
+        case SweepParameter::PROCESSING_TIME:   return "processing-time";
+        case SweepParameter::DELIVERY_INTERVAL: return "delivery-interval";
+        case SweepParameter::QUEUE_TYPE:        return "queue-type";
+    }
+    return "";
+}
+
+SweepAxis parse_sweep_axis(const std::string& text) {
+    auto at = text.find('@');
+    auto eq = text.find('=');
+    if (at == std::string::npos || eq == std::string::npos || eq < at) {
+        throw std::logic_error("Invalid sweep axis format");
+    }
+
+    SweepAxis axis;
+    std::string name = text.substr(0, at);
+    if (name == "processing-time") {
+        axis.parameter = SweepParameter::PROCESSING_TIME;
+    } else if (name == "delivery-interval") {
+        axis.parameter = SweepParameter::DELIVERY_INTERVAL;
+    } else if (name == "queue-type") {
+        axis.parameter = SweepParameter::QUEUE_TYPE;
+    } else {
+        throw std::logic_error("Unknown sweep parameter");
+    }
+    axis.node = std::stoi(text.substr(at + 1, eq - at - 1));
+
+    std::istringstream values(text.substr(eq + 1));
+    std::string v;
+    while (std::getline(values, v, ',')) {
+        if (axis.parameter != SweepParameter::QUEUE_TYPE) {
+            axis.values.push_back(std::stoi(v));
+        } else if (v == "FIFO") {
+            axis.values.push_back(static_cast<int>(PackageQueueType::FIFO));
+        } else if (v == "LIFO") {
+            axis.values.push_back(static_cast<int>(PackageQueueType::LIFO));
+        } else if (v == "PRIORITY") {
+            axis.values.push_back(static_cast<int>(PackageQueueType::PRIORITY));
+        } else if (v == "EDF") {
+            axis.values.push_back(static_cast<int>(PackageQueueType::EDF));
+        } else {
+            throw std::logic_error("Unknown queue type");
+        }
+    }
+    if (axis.values.empty()) {
+        throw std::logic_error("Sweep axis without values");
+    }
+    return axis;
+}
+
+std::string sweep_axis_name(const SweepAxis& axis) {
+    return std::string(parameter_name(axis.parameter)) + "@" + std::to_string(axis.node);
+}
+
+std::string sweep_value_name(const SweepAxis& axis, int value) {
+    if (axis.parameter != SweepParameter::QUEUE_TYPE) {
+        return std::to_string(value);
+    }
+    switch (static_cast<PackageQueueType>(value)) {
+        case PackageQueueType::FIFO:     return "FIFO";
+        case PackageQueueType::LIFO:     return "LIFO";
+        case PackageQueueType::PRIORITY: return "PRIORITY";
+        case PackageQueueType::EDF:      return "EDF";
+    }
+    return std::to_string(value);
+}
+
+// =======================================================
+// Warianty
+// =======================================================
+
+std::vector<std::vector<int>> sweep_variants(
+    const std::vector<SweepAxis>& axes,
+    const SweepOptions& options
+) {
+    std::vector<std::vector<int>> variants;
+
+    if (options.sampling == SweepSampling::GRID) {
+        // iloczyn kartezjański, ostatnia oś zmienia się najszybciej
+        std::vector<std::size_t> index(axes.size(), 0);
+        while (true) {
+            std::vector<int> values;
+            for (std::size_t a = 0; a < axes.size(); ++a) {
+                values.push_back(axes[a].values[index[a]]);
+            }
+            variants.push_back(std::move(values));
+
+            std::size_t a = axes.size();
+            while (a > 0) {
+                --a;
+                if (++index[a] < axes[a].values.size()) break;
+                index[a] = 0;
+                if (a == 0) return variants;
+            }
+            if (axes.empty()) return variants;
+        }
+    }
+
+    // LHS: każda oś dzielona na n warstw, każda warstwa użyta dokładnie raz
+    const std::size_t n = options.samples;
+    std::mt19937_64 rng(options.seed);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+
+    variants.assign(n, std::vector<int>(axes.size()));
+    std::vector<std::size_t> strata(n);
+    for (std::size_t a = 0; a < axes.size(); ++a) {
+        for (std::size_t i = 0; i < n; ++i) strata[i] = i;
+        std::shuffle(strata.begin(), strata.end(), rng);
+
+        const std::size_t m = axes[a].values.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            double x = (strata[i] + u(rng)) / n;   // punkt w [0, 1)
+            std::size_t k = std::min(m - 1, static_cast<std::size_t>(x * m));
+            variants[i][a] = axes[a].values[k];
+        }
+    }
+    return variants;
+}
+
+FactoryDraft make_variant(
+    const FactoryDraft& base,
+    const std::vector<SweepAxis>& axes,
+    const std::vector<int>& values
+) {
+    FactoryDraft draft = base;
+
+    for (std::size_t a = 0; a < axes.size(); ++a) {
+        const SweepAxis& axis = axes[a];
+        bool found = false;
+
+        if (axis.parameter == SweepParameter::DELIVERY_INTERVAL) {
+            for (auto& r : draft.ramps) {
+                if (r.id != axis.node) continue;
+                if (r.traced) {
+                    throw std::logic_error("Cannot sweep delivery interval of a trace ramp");
+                }
+                r.di = values[a];
+                found = true;
+            }
+        } else {
+            for (auto& w : draft.workers) {
+                if (w.id != axis.node) continue;
+                if (axis.parameter == SweepParameter::PROCESSING_TIME) {
+                    w.pt = values[a];
+                } else {
+                    w.qt = static_cast<PackageQueueType>(values[a]);
+                }
+                found = true;
+            }
+        }
+
+        if (!found) {
+            throw std::logic_error("Sweep axis node not found");
+        }
+    }
+    return draft;
+}
+
+// =======================================================
+// Podsumowanie jednego wariantu
+// =======================================================
+
+SweepResult summarize_run(const Factory& f, TimeOffset turns) {
+    SweepResult r;
+
+    for (auto it = f.storehouse_cbegin(); it != f.storehouse_cend(); ++it) {
+        r.delivered += it->get_stockpile()->size();
+    }
+    r.throughput = (turns > 0) ? static_cast<double>(r.delivered) / turns : 0.0;
+
+    for (auto it = f.ramp_cbegin(); it != f.ramp_cend(); ++it) {
+        if (it->has_package()) ++r.in_process;
+    }
+    for (auto it = f.worker_cbegin(); it != f.worker_cend(); ++it) {
+        std::size_t q = it->get_queue()->size();
+        r.in_process += q + it->get_in_process_count() + (it->has_package() ? 1 : 0);
+        if (q > r.max_queue) {
+            r.max_queue = q;
+            r.bottleneck = it->get_id();
+        }
+    }
+    return r;
+}
+
+// =======================================================
+// Funkcja run_sweep()
+// =======================================================
+
+std::vector<SweepResult> run_sweep(
+    const FactoryDraft& base,
+    const std::vector<SweepAxis>& axes,
+    const SweepOptions& options
+) {
+    std::vector<std::vector<int>> variants = sweep_variants(axes, options);
+
+    // szkice budowane przed startem wątków (błędy osi zgłaszane od razu)
+    std::vector<FactoryDraft> drafts;
+    drafts.reserve(variants.size());
+    for (const auto& values : variants) {
+        drafts.push_back(make_variant(base, axes, values));
+    }
+
+    std::vector<SweepResult> results(variants.size());
+    std::vector<std::exception_ptr> errors(variants.size());
+    std::atomic<std::size_t> next(0);
+
+    auto run = [&]() {
+        for (std::size_t i = next++; i < drafts.size(); i = next++) {
+            try {
+                Package::load_registry({}, {});
+                {
+                    Factory f = IO::build_factory(drafts[i]);
+                    simulate(f, options.turns, [](Factory&, Time) {});
+                    results[i] = summarize_run(f, options.turns);
+                }
+                results[i].values = variants[i];
+                Package::load_registry({}, {});
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    unsigned threads = options.threads;
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, drafts.size()));
+
+    std::vector<std::thread> pool;
+    for (unsigned k = 0; k < threads; ++k) {
+        pool.emplace_back(run);
+    }
+    for (auto& t : pool) {
+        t.join();
+    }
+
+    for (const auto& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+    return results;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+// ==============================
+// Sweep.hpp
+// ==============================
+// Równoległy przegląd parametrów topologii
+//
+// Odpowiada za:
+// - wyznaczenie wariantów: pełna siatka albo próbka
+//   łacińskiego hipersześcianu (LHS) z wartości osi
+// - budowanie wariantów ze szkicu FactoryDraft (bez ponownego parsowania)
+// - symulację wariantów równolegle na puli wątków
+// - jeden wiersz podsumowania na wariant
+//
+// Każdy wątek ma własny rejestr ID paczek (thread_local), a rejestr jest
+// zerowany przed każdym wariantem -> wynik nie zależy od przydziału
+// wariantów do wątków.
+// ==============================
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "io/Parser.hpp"
+
+// =======================================================
+// Osie przeglądu
+// =======================================================
+
+enum class SweepParameter { PROCESSING_TIME, DELIVERY_INTERVAL, QUEUE_TYPE };
+
+// Wartości QUEUE_TYPE: static_cast<int>(PackageQueueType)
+struct SweepAxis {
+    SweepParameter parameter;
+    ElementID node;           // robotnik (PROCESSING_TIME, QUEUE_TYPE) lub rampa
+    std::vector<int> values;
+};
+
+// Oś z tekstu: <parametr>@<id>=<v1>,<v2>,...
+// np. processing-time@2=1,2,3  queue-type@3=FIFO,LIFO
+SweepAxis parse_sweep_axis(const std::string& text);
+
+// Nazwa osi (kolumna podsumowania), np. processing-time@2
+std::string sweep_axis_name(const SweepAxis& axis);
+
+// Wartość osi jako tekst (FIFO/LIFO/PRIORITY/EDF dla QUEUE_TYPE)
+std::string sweep_value_name(const SweepAxis& axis, int value);
+
+// =======================================================
+// Parametry i wynik
+// =======================================================
+
+enum class SweepSampling { GRID, LATIN_HYPERCUBE };
+
+struct SweepOptions {
+    TimeOffset turns = 1000;
+    SweepSampling sampling = SweepSampling::GRID;
+    std::size_t samples = 0;        // liczba wariantów LHS
+    std::uint64_t seed = 1;         // ziarno LHS
+    unsigned threads = 0;           // 0 -> std::thread::hardware_concurrency()
+};
+
+struct SweepResult {
+    std::vector<int> values;        // wartości kolejnych osi
+    std::size_t delivered = 0;      // paczki w magazynach
+    double throughput = 0.0;        // delivered / turns
+    std::size_t in_process = 0;     // paczki w kolejkach, obróbce i buforach
+    ElementID bottleneck = 0;       // robotnik z najdłuższą kolejką (0 -> brak)
+    std::size_t max_queue = 0;      // długość tej kolejki
+};
+
+// =======================================================
+// Przegląd
+// =======================================================
+
+// Warianty (wartości osi) w kolejności podsumowania
+std::vector<std::vector<int>> sweep_variants(
+    const std::vector<SweepAxis>& axes,
+    const SweepOptions& options
+);
+
+// Podsumowanie fabryki po turns turach (bez pola values)
+SweepResult summarize_run(const Factory& f, TimeOffset turns);
+
+// Szkic bazowy z podstawionymi wartościami osi
+FactoryDraft make_variant(
+    const FactoryDraft& base,
+    const std::vector<SweepAxis>& axes,
+    const std::vector<int>& values
+);
+
+std::vector<SweepResult> run_sweep(
+    const FactoryDraft& base,
+    const std::vector<SweepAxis>& axes,
+    const SweepOptions& options
+);
@@ -0,0 +1,777 @@
+#include "TimeWarp.hpp"
+#include "Partition.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+// =======================================================
+// Plan przebiegu (wspólny, tylko do odczytu)
+// =======================================================
+
+struct WarpPlan {
+    std::vector<std::size_t> sender_part;       // indeks nadawcy -> część
+    std::vector<std::size_t> worker_part;
+    std::vector<std::size_t> storehouse_part;
+    std::vector<TimeOffset> intervals;          // interwały dostaw ramp
+    ElementID id_base;                          // ID pierwszej paczki przebiegu
+
+    std::size_t owner(ReceiverHandle h) const {
+        return (h.type == ReceiverType::WORKER) ? worker_part[h.index]
+                                                : storehouse_part[h.index];
+    }
+};
+
+// Dostawy rampy w turach 1..t (reguła Ramp::deliver_goods)
+static ElementID deliveries_until(Time t, TimeOffset interval) {
+    return (t >= 1) ? (t - 1) / interval + 1 : 0;
+}
+
+// ID paczki rampy r w turze t: jak w Factory::do_deliveries
+// (rampy po kolei, każda dostawa -> kolejne ID)
+static ElementID delivery_id(const WarpPlan& plan, Time t, std::size_t r) {
+    ElementID id = plan.id_base;
+    for (std::size_t j = 0; j < plan.intervals.size(); ++j) {
+        id += deliveries_until(t - 1, plan.intervals[j]);
+        if (j < r && (t - 1) % plan.intervals[j] == 0) ++id;
+    }
+    return id;
+}
+
+// Pierwsza tura >= t spełniająca regułę rampy (t - 1) % interval == 0
+static Time first_delivery_from(Time t, TimeOffset interval) {
+    Time r = (t - 1) % interval;
+    if (r < 0) r += interval;
+    return (r == 0) ? t : t + (interval - r);
+}
+
+// =======================================================
+// Wiadomości i runda GVT
+// =======================================================
+
+// Paczka poza fabryką: ID z atrybutami kolejek PRIORITY / EDF
+struct WarpPackage {
+    ElementID id;
+    int priority;
+    Time deadline;
+};
+
+static WarpPackage to_warp(const Package& p) {
+    return WarpPackage{p.getID(), p.get_priority(), p.get_deadline()};
+}
+
+static Package from_warp(const WarpPackage& p) {
+    return Package::restore(p.id, p.priority, p.deadline);
+}
+
+struct WarpMessage {
+    Time t;                  // tura przekazania
+    std::uint32_t sender;    // indeks nadawcy w FactorySnapshot
+    ReceiverHandle receiver;
+    WarpPackage package;
+    bool anti;               // odwołanie paczki (t, sender)
+};
+
+struct WarpMailbox {
+    std::mutex m;
+    std::vector<WarpMessage> messages;   // w kolejności wysłania
+};
+
+class WarpControl {
+public:
+    explicit WarpControl(std::size_t parts)
+        : mailboxes_(new WarpMailbox[parts]), lvt_(parts, 0) {}
+
+    void post(std::size_t to, const WarpMessage& message) {
+        std::lock_guard<std::mutex> lock(mailboxes_[to].m);
+        mailboxes_[to].messages.push_back(message);
+    }
+
+    void take(std::size_t me, std::vector<WarpMessage>& out) {
+        out.clear();
+        std::lock_guard<std::mutex> lock(mailboxes_[me].m);
+        std::swap(out, mailboxes_[me].messages);
+    }
+
+    void request() { requested_.store(true, std::memory_order_release); }
+    bool requested() const { return requested_.load(std::memory_order_acquire); }
+
+    void fail(std::exception_ptr error) {
+        std::lock_guard<std::mutex> lock(m_);
+        if (!error_) error_ = error;
+        failed_.store(true);
+        cv_.notify_all();
+    }
+    bool failed() const { return failed_.load(); }
+    std::exception_ptr error() const { return error_; }
+
+    // Runda: czeka na wszystkie części, ostatnia liczy
+    // GVT = min(LVT części, czasy wiadomości w skrzynkach).
+    // false -> inna część zgłosiła wyjątek
+    bool join(std::size_t me, Time lvt, Time& gvt) {
+        std::unique_lock<std::mutex> lock(m_);
+        lvt_[me] = lvt;
+        const std::uint64_t round = round_;
+
+        if (++arrived_ == lvt_.size()) {
+            Time g = *std::min_element(lvt_.begin(), lvt_.end());
+            for (std::size_t p = 0; p < lvt_.size(); ++p) {
+                std::lock_guard<std::mutex> box(mailboxes_[p].m);
+                for (const WarpMessage& m : mailboxes_[p].messages) {
+                    g = std::min(g, m.t);
+                }
+            }
+            gvt_ = g;
+            arrived_ = 0;
+            ++round_;
+            requested_.store(false);
+            cv_.notify_all();
+        } else {
+            cv_.wait(lock, [&] { return round_ != round || failed_.load(); });
+        }
+
+        gvt = gvt_;
+        return !failed_.load();
+    }
+
+private:
+    std::unique_ptr<WarpMailbox[]> mailboxes_;
+
+    std::mutex m_;
+    std::condition_variable cv_;
+    std::vector<Time> lvt_;
+    std::size_t arrived_ = 0;
+    std::uint64_t round_ = 0;
+    Time gvt_ = 1;
+
+    std::atomic<bool> requested_{false};
+    std::atomic<bool> failed_{false};
+    std::exception_ptr error_;
+};
+
+// =======================================================
+// Zapis stanu części
+// =======================================================
+
+struct WarpSenderState {
+    bool has_package;
+    WarpPackage package;
+    long long blocked_turns;
+    std::uint64_t position;    // pozycja RandomStream (0 dla FixedProbability)
+};
+
+struct InFlightWarp {
+    WarpPackage package;
+    Time start;
+    TimeOffset duration;
+};
+
+struct WarpWorkerState {
+    std::vector<WarpPackage> queue;   // w kolejności kontenera
+    bool processing;
+    WarpPackage package;
+    Time start;
+    TimeOffset duration;
+    std::vector<InFlightWarp> in_flight;  // k > 1 lub B > 1
+    std::vector<WarpPackage> finished;
+    std::uint64_t position;         // strumień czasów obróbki
+    WorkerStats stats;
+};
+
+struct WarpStoreState {
+    std::size_t size;               // FULL: magazyn tylko rośnie -> obcięcie
+    // SUMMARY: pełny stan podsumowania
+    bool summary = false;
+    Time current_time = 0;
+    TimeOffset bucket_width = 0;
+    std::vector<std::size_t> histogram;
+    std::vector<WarpPackage> sample;
+    std::string rng;
+    DeadlineStats deadlines;
+};
+
+// Stan na początku tury turn
+struct WarpState {
+    Time turn;
+    std::vector<WarpSenderState> senders;
+    std::vector<WarpWorkerState> workers;
+    std::vector<WarpStoreState> stores;
+};
+
+// =======================================================
+// Część
+// =======================================================
+
+struct WarpInput {
+    ReceiverHandle receiver;
+    WarpPackage package;
+};
+
+struct WarpSent {
+    WarpMessage message;
+    std::size_t part;
+};
+
+struct WarpDelivery {
+    std::uint32_t sender;
+    ReceiverHandle receiver;
+    Package package;
+};
+
+class WarpPart {
+public:
+    WarpPart(const FactorySnapshot& snap, const WarpPlan& plan, std::size_t me,
+             WarpControl& control, TimeOffset d, const OptimisticOptions& options)
+        : snap_(snap), plan_(plan), me_(me), control_(control), d_(d), options_(options) {
+        for (std::size_t i = 0; i < plan.sender_part.size(); ++i) {
+            if (plan.sender_part[i] != me) continue;
+            senders_.push_back(i);
+            if (i < snap.ramps().size()) ramps_.push_back(i);
+        }
+        for (std::size_t i = 0; i < plan.worker_part.size(); ++i) {
+            if (plan.worker_part[i] != me) continue;
+            workers_.push_back(i);
+            snap.workers()[i]->attach_clock(&clock_);
+        }
+        for (std::size_t i = 0; i < plan.storehouse_part.size(); ++i) {
+            if (plan.storehouse_part[i] == me) stores_.push_back(i);
+        }
+    }
+
+    void run();
+    const RollbackStats& stats() const { return stats_; }
+
+private:
+    void receive();
+    void execute(Time t);
+    Time next_event(Time t) const;
+    void rollback(Time r);
+    void cancel_outputs(Time r);
+    void save(Time turn);
+    void restore(const WarpState& state);
+    void fossil_collect();
+
+    const FactorySnapshot& snap_;
+    const WarpPlan& plan_;
+    const std::size_t me_;
+    WarpControl& control_;
+    const TimeOffset d_;
+    const OptimisticOptions& options_;
+
+    // własne węzły (indeksy obrazu, rosnąco)
+    std::vector<std::size_t> ramps_;
+    std::vector<std::size_t> senders_;
+    std::vector<std::size_t> workers_;
+    std::vector<std::size_t> stores_;
+
+    Time clock_ = 0;   // zegar robotników części (czas przybycia paczek)
+    Time lvt_ = 1;     // następna tura do wykonania
+    Time last_ = 0;    // ostatnia wykonana tura
+    Time gvt_ = 1;
+    // tury < resend_from_: paczki do innych części już wysłane i nadal ważne
+    // (wykonane tury <= last_ albo tury po last_ sprzed cofnięcia)
+    Time resend_from_ = 1;
+
+    std::map<std::pair<Time, std::uint32_t>, WarpInput> inputs_;   // (tura, nadawca)
+    std::deque<WarpSent> outputs_;
+    std::deque<WarpState> states_;
+    std::deque<Time> executed_;
+
+    std::vector<WarpMessage> incoming_;
+    std::vector<WarpDelivery> deliveries_;
+    RollbackStats stats_;
+};
+
+void WarpPart::run() {
+    save(1);
+    lvt_ = next_event(0);
+
+    TimeOffset since = 0;   // tury od ostatniej rundy GVT
+    for (;;) {
+        if (control_.failed()) return;
+        receive();
+
+        const bool can_run = lvt_ <= d_ &&
+            (options_.window <= 0 || lvt_ < gvt_ + options_.window);
+
+        if (control_.requested() && (!can_run || since >= options_.gvt_interval)) {
+            if (!control_.join(me_, lvt_, gvt_)) return;
+            ++stats_.gvt_rounds;
+            since = 0;
+            if (gvt_ > d_) return;
+            fossil_collect();
+            continue;
+        }
+        if (!can_run) {
+            control_.request();
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (lvt_ - states_.back().turn >= options_.state_interval) {
+            save(lvt_);
+        }
+        execute(lvt_);
+        executed_.push_back(lvt_);
+        last_ = lvt_;
+        ++stats_.turns;
+        lvt_ = next_event(lvt_);
+
+        if (++since >= options_.gvt_interval) {
+            control_.request();
+        }
+    }
+}
+
+// Wiadomości ze skrzynki: paczki do wejść, odwołania usuwają paczki;
+// czas <= last_ -> cofnięcie. Zmiana wejścia tury t > last_ nie wymaga
+// cofnięcia, ale unieważnia paczki zachowane z tur > t (przed
+// cofnięciem wysłane z tur po last_) -> odwołanie i ponowne wysłanie.
+void WarpPart::receive() {
+    control_.take(me_, incoming_);
+
+    for (const WarpMessage& m : incoming_) {
+        const auto key = std::make_pair(m.t, m.sender);
+
+        if (!m.anti) {
+            if (!inputs_.emplace(key, WarpInput{m.receiver, m.package}).second) {
+                throw std::logic_error("Duplicate package message");
+            }
+            if (m.t <= last_) {
+                ++stats_.straggler_rollbacks;
+                rollback(m.t);
+            } else {
+                cancel_outputs(m.t);
+            }
+            lvt_ = std::min(lvt_, m.t);
+            continue;
+        }
+
+        // odwołanie przychodzi po paczce (skrzynka zachowuje kolejność nadawcy)
+        if (inputs_.find(key) == inputs_.end()) {
+            throw std::logic_error("Anti-message without package");
+        }
+        if (m.t <= last_) {
+            ++stats_.anti_rollbacks;
+            rollback(m.t);
+        } else {
+            ++stats_.annihilated;
+            cancel_outputs(m.t);
+        }
+        inputs_.erase(key);
+    }
+}
+
+// Tura t części (te same fazy co simulate())
+void WarpPart::execute(Time t) {
+    clock_ = t;
+
+    // 1️⃣ Dostawy
+    for (std::size_t r : ramps_) {
+        if ((t - 1) % plan_.intervals[r] == 0) {
+            const Ramp* ramp = snap_.ramps()[r];
+            Package p = Package::restore(delivery_id(plan_, t, r));
+            p.set_priority(ramp->get_priority());
+            if (ramp->get_deadline() > 0) p.set_deadline(t + ramp->get_deadline());
+            snap_.ramps()[r]->push_package(std::move(p));
+        }
+    }
+    for (std::size_t i : stores_) {
+        snap_.storehouses()[i]->set_time(t);
+    }
+
+    // 2️⃣ Przekazywanie: własne paczki + paczki innych części z tury t,
+    //    dostarczane w kolejności indeksu nadawcy
+    deliveries_.clear();
+    for (std::size_t i : senders_) {
+        PackageSender* sender = snap_.senders()[i];
+        if (!sender->has_package()) continue;
+
+        std::uint32_t k = snap_.choose(i);
+        if (k == FactorySnapshot::NO_RECEIVER) continue;
+
+        ReceiverHandle h = snap_.successors()[k];
+        std::size_t q = plan_.owner(h);
+        Package p = sender->take_package();
+        if (q == me_) {
+            deliveries_.push_back(WarpDelivery{static_cast<std::uint32_t>(i), h, std::move(p)});
+            continue;
+        }
+        if (t < resend_from_) continue;   // ta sama paczka wysłana przed cofnięciem
+
+        WarpMessage m{t, static_cast<std::uint32_t>(i), h, to_warp(p), false};
+        outputs_.push_back(WarpSent{m, q});
+        control_.post(q, m);
+        ++stats_.messages;
+    }
+
+    for (auto it = inputs_.lower_bound({t, 0}); it != inputs_.end() && it->first.first == t; ++it) {
+        deliveries_.push_back(WarpDelivery{
+            it->first.second, it->second.receiver, from_warp(it->second.package)});
+    }
+    std::sort(deliveries_.begin(), deliveries_.end(),
+        [](const WarpDelivery& a, const WarpDelivery& b) { return a.sender < b.sender; });
+    for (WarpDelivery& x : deliveries_) {
+        snap_.dispatch(x.receiver, std::move(x.package));
+    }
+
+    // 3️⃣ Praca
+    for (std::size_t i : workers_) {
+        Worker* w = snap_.workers()[i];
+        if (w->has_work()) w->do_work(t);
+    }
+}
+
+// Najbliższa tura > t ze zdarzeniem części (jak Factory::next_event_time),
+// najwyżej d + 1
+Time WarpPart::next_event(Time t) const {
+    Time next = d_ + 1;
+
+    for (std::size_t i : senders_) {
+        if (snap_.senders()[i]->has_package()) return t + 1;
+    }
+    for (std::size_t r : ramps_) {
+        next = std::min(next, first_delivery_from(t + 1, plan_.intervals[r]));
+    }
+    for (std::size_t i : workers_) {
+        const Worker* w = snap_.workers()[i];
+        if (!w->has_work()) continue;
+        next = std::min(next, w->next_work_time(t));
+    }
+
+    auto in = inputs_.lower_bound({t + 1, 0});
+    if (in != inputs_.end()) {
+        next = std::min(next, in->first.first);
+    }
+    return std::min(next, d_ + 1);
+}
+
+// Odwołanie paczek wysłanych z tur > r; tury > r wyślą paczki ponownie
+void WarpPart::cancel_outputs(Time r) {
+    if (r + 1 >= resend_from_) return;   // brak zachowanych paczek po r
+    resend_from_ = r + 1;
+
+    while (!outputs_.empty() && outputs_.back().message.t > r) {
+        WarpMessage anti = outputs_.back().message;
+        anti.anti = true;
+        control_.post(outputs_.back().part, anti);
+        outputs_.pop_back();
+        ++stats_.anti_messages;
+    }
+}
+
+// Powrót do stanu sprzed tury r: odwołanie paczek z tur > r,
+// odtworzenie zapisu <= r i tur od zapisu do r. Paczki z tur <= r
+// zależą tylko od stanu sprzed r, więc nie są wysyłane ponownie.
+void WarpPart::rollback(Time r) {
+    ++stats_.rollbacks;
+    resend_from_ = std::max(resend_from_, last_ + 1);   // wykonane tury już wysłały
+    cancel_outputs(r);
+
+    while (!executed_.empty() && executed_.back() >= r) {
+        executed_.pop_back();
+        ++stats_.rolled_back_turns;
+    }
+
+    while (states_.size() > 1 && states_.back().turn > r) {
+        states_.pop_back();
+    }
+    if (states_.back().turn > r) {
+        throw std::logic_error("Rollback before the oldest saved state");
+    }
+    restore(states_.back());
+
+    Time t = states_.back().turn;
+    last_ = t - 1;
+    while (t < r) {
+        execute(t);
+        ++stats_.coast_turns;
+        last_ = t;
+        t = next_event(t);
+    }
+    lvt_ = t;
+}
+
+void WarpPart::save(Time turn) {
+    WarpState st;
+    st.turn = turn;
+
+    for (std::size_t i : senders_) {
+        const PackageSender* s = snap_.senders()[i];
+        const RandomStream* stream =
+            s->receiver_preferences.get_probability_generator().target<RandomStream>();
+        st.senders.push_back(WarpSenderState{
+            s->has_package(),
+            s->has_package() ? to_warp(s->get_package()) : WarpPackage{},
+            s->get_blocked_turns(),
+            stream ? stream->get_position() : 0});
+    }
+
+    for (std::size_t i : workers_) {
+        const Worker* w = snap_.workers()[i];
+        WarpWorkerState ws;
+        for (auto it = w->cbegin(); it != w->cend(); ++it) {
+            ws.queue.push_back(to_warp(*it));
+        }
+        ws.processing = w->is_processing();
+        ws.package = ws.processing ? to_warp(w->get_processing_package()) : WarpPackage{};
+        ws.start = w->get_package_processing_start_time();
+        ws.duration = w->get_processing_duration();
+        for (const InFlightPackage& p : w->get_in_flight()) {
+            ws.in_flight.push_back(InFlightWarp{to_warp(p.package), p.start, p.duration});
+        }
+        for (const Package& p : w->get_finished()) {
+            ws.finished.push_back(to_warp(p));
+        }
+        ws.stats = w->get_stats();
+        ws.position = w->get_processing_stream().get_position();
+        st.workers.push_back(std::move(ws));
+    }
+
+    for (std::size_t i : stores_) {
+        const Storehouse* store = snap_.storehouses()[i];
+        const IPackageStockpile* stockpile = store->get_stockpile();
+        WarpStoreState ss;
+        ss.size = stockpile->size();
+        ss.deadlines = store->get_deadline_stats();
+        if (auto summary = dynamic_cast<const PackageSummary*>(stockpile)) {
+            ss.summary = true;
+            ss.current_time = summary->get_current_time();
+            ss.bucket_width = summary->get_bucket_width();
+            ss.histogram = summary->get_histogram();
+            for (auto it = summary->cbegin(); it != summary->cend(); ++it) {
+                ss.sample.push_back(to_warp(*it));
+            }
+            ss.rng = summary->get_rng_state();
+        }
+        st.stores.push_back(std::move(ss));
+    }
+
+    states_.push_back(std::move(st));
+    ++stats_.states_saved;
+}
+
+void WarpPart::restore(const WarpState& st) {
+    for (std::size_t k = 0; k < senders_.size(); ++k) {
+        PackageSender* s = snap_.senders()[senders_[k]];
+        const WarpSenderState& x = st.senders[k];
+
+        if (s->has_package()) s->take_package();
+        if (x.has_package) s->push_package(from_warp(x.package));
+        s->restore_blocked_turns(x.blocked_turns);
+        if (auto stream = s->receiver_preferences.get_probability_generator().target<RandomStream>()) {
+            stream->set_position(x.position);
+        }
+    }
+
+    for (std::size_t k = 0; k < workers_.size(); ++k) {
+        Worker* w = snap_.workers()[workers_[k]];
+        const WarpWorkerState& x = st.workers[k];
+
+        IPackageQueue* q = w->get_queue();
+        while (!q->empty()) q->pop();
+        for (const WarpPackage& p : x.queue) {
+            w->restore_queued(from_warp(p));
+        }
+        w->clear_processing();
+        if (x.processing) w->restore_processing(from_warp(x.package), x.start, x.duration);
+        for (const InFlightWarp& p : x.in_flight) {
+            w->restore_in_flight(from_warp(p.package), p.start, p.duration);
+        }
+        for (const WarpPackage& p : x.finished) {
+            w->restore_finished(from_warp(p));
+        }
+        w->restore_stats(x.stats);
+        w->restore_processing_position(x.position);
+    }
+
+    for (std::size_t k = 0; k < stores_.size(); ++k) {
+        Storehouse* store = snap_.storehouses()[stores_[k]];
+        IPackageStockpile* stockpile = store->get_stockpile();
+        const WarpStoreState& x = st.stores[k];
+        store->restore_deadline_stats(x.deadlines);
+
+        if (x.summary) {
+            std::vector<Package> sample;
+            for (const WarpPackage& p : x.sample) {
+                sample.push_back(from_warp(p));
+            }
+            static_cast<PackageSummary*>(stockpile)->restore_state(
+                x.size, x.current_time, x.bucket_width, x.histogram, std::move(sample), x.rng);
+            continue;
+        }
+
+        // kolejka magazynu: paczki po x.size zostały dodane po zapisie
+        auto q = static_cast<IPackageQueue*>(stockpile);
+        if (q->getQueueType() == PackageQueueType::LIFO) {
+            while (q->size() > x.size) q->pop();
+        } else if (q->getQueueType() == PackageQueueType::PRIORITY ||
+                   q->getQueueType() == PackageQueueType::EDF) {
+            // kontener jest w kolejności przyjęcia, pop() już nie
+            std::vector<Package> kept;
+            for (auto it = q->cbegin(); kept.size() < x.size; ++it) {
+                kept.push_back(Package::restore(it->getID(), it->get_priority(), it->get_deadline()));
+            }
+            while (!q->empty()) q->pop();
+            for (Package& p : kept) q->push(std::move(p));
+        } else {
+            const std::size_t n = q->size();
+            for (std::size_t j = 0; j < n; ++j) {
+                Package p = q->pop();
+                if (j < x.size) q->push(std::move(p));
+            }
+        }
+    }
+}
+
+// Usuwa zapisy, wejścia i wyjścia, których nie dotknie żadne cofnięcie (>= GVT)
+void WarpPart::fossil_collect() {
+    while (states_.size() > 1 && states_[1].turn <= gvt_) {
+        states_.pop_front();
+    }
+    const Time keep = states_.front().turn;
+
+    inputs_.erase(inputs_.begin(), inputs_.lower_bound({keep, 0}));
+    while (!outputs_.empty() && outputs_.front().message.t < gvt_) {
+        outputs_.pop_front();
+    }
+    while (!executed_.empty() && executed_.front() < keep) {
+        executed_.pop_front();
+    }
+}
+
+// =======================================================
+// Funkcja simulate_optimistic()
+// =======================================================
+
+std::vector<RollbackStats> simulate_optimistic(
+    Factory& f,
+    TimeOffset d,
+    std::function<void(Factory&, Time)> rf,
+    const OptimisticOptions& options
+) {
+    if (options.parts == 0) {
+        throw std::invalid_argument("Number of parts must be positive");
+    }
+    if (options.state_interval <= 0 || options.gvt_interval <= 0) {
+        throw std::invalid_argument("State and GVT intervals must be positive");
+    }
+    if (!f.is_consistent()) {
+        throw std::logic_error("Factory network is not consistent");
+    }
+    for (auto it = f.worker_cbegin(); it != f.worker_cend(); ++it) {
+        if (it->get_queue_capacity() > 0) {
+            // przyjęcie paczki zależy od stanu odbiorcy w innej części
+            throw std::logic_error("simulate_optimistic does not support bounded queues");
+        }
+    }
+    if (d <= 0) return std::vector<RollbackStats>(options.parts);
+
+    const FactorySnapshot& snap = f.snapshot();
+    for (Ramp* r : snap.ramps()) {
+        if (!r->has_fixed_schedule()) {
+            // ID paczek z numeru tury wymagają stałych odstępów dostaw
+            throw std::logic_error("simulate_optimistic requires fixed delivery intervals");
+        }
+    }
+    for (PackageSender* s : snap.senders()) {
+        const auto& pg = s->receiver_preferences.get_probability_generator();
+        if (!pg.target<FixedProbability>() && !pg.target<RandomStream>()) {
+            throw std::logic_error("Probability generator cannot be rolled back");
+        }
+    }
+    for (Storehouse* store : snap.storehouses()) {
+        if (!dynamic_cast<PackageSummary*>(store->get_stockpile()) &&
+            !dynamic_cast<IPackageQueue*>(store->get_stockpile())) {
+            throw std::logic_error("Storehouse stockpile cannot be rolled back");
+        }
+    }
+
+    std::vector<ElementID> assigned, freed;
+    ElementID prefix;
+    Package::save_registry(assigned, freed, prefix);
+    if (!freed.empty()) {
+        throw std::logic_error("simulate_optimistic requires no freed package IDs");
+    }
+
+    FactoryPartition partition = partition_factory(f, options.parts, options.balance);
+    WarpPlan plan;
+    plan.sender_part = partition.ramps;
+    plan.sender_part.insert(plan.sender_part.end(),
+                            partition.workers.begin(), partition.workers.end());
+    plan.worker_part = partition.workers;
+    plan.storehouse_part = partition.storehouses;
+    plan.intervals = snap.delivery_intervals();
+    plan.id_base = Package::next_id();
+    for (TimeOffset interval : plan.intervals) {
+        if (interval <= 0) {
+            throw std::logic_error("Invalid delivery interval");
+        }
+    }
+
+    // węzły należą do wątków części -> bez zbiorów aktywnych fabryki
+    for (PackageSender* s : snap.senders()) {
+        s->attach_sender_set(nullptr, 0);
+    }
+    for (Worker* w : snap.workers()) {
+        w->attach_worker_set(nullptr, 0);
+    }
+
+    WarpControl control(options.parts);
+    std::vector<std::unique_ptr<WarpPart>> parts;
+    for (std::size_t p = 0; p < options.parts; ++p) {
+        parts.emplace_back(new WarpPart(snap, plan, p, control, d, options));
+    }
+
+    std::vector<std::thread> threads;
+    for (std::size_t p = 0; p < options.parts; ++p) {
+        threads.emplace_back([&parts, &control, p] {
+            try {
+                parts[p]->run();
+            } catch (...) {
+                control.fail(std::current_exception());
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    for (Worker* w : snap.workers()) {
+        w->attach_clock(nullptr);
+    }
+    if (control.error()) {
+        f.invalidate();
+        std::rethrow_exception(control.error());
+    }
+
+    // rejestr ID jak po sekwencyjnym przebiegu, zegar magazynów = ostatnia tura
+    ElementID created = 0;
+    for (TimeOffset interval : plan.intervals) {
+        created += deliveries_until(d, interval);
+    }
+    Package::claim_ids(created);
+    for (Storehouse* store : snap.storehouses()) {
+        store->set_time(d);
+    }
+
+    // zbiory aktywne, zegar i koło dostaw powstaną od nowa z bieżącego stanu
+    f.invalidate();
+
+    std::vector<RollbackStats> stats;
+    for (const auto& part : parts) {
+        stats.push_back(part->stats());
+    }
+
+    rf(f, d);
+    return stats;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+// ==============================
+// TimeWarp.hpp
+// ==============================
+// Optymistyczna równoległa symulacja zdarzeń (Time Warp)
+//
+// Odpowiada za:
+// - podział grafu na części (partition_factory), jedna część na wątek
+// - niezależny postęp części: każda część wykonuje swoje tury od razu,
+//   pomijając tury bez zdarzeń (jak simulate_event_driven), bez czekania
+//   na paczki z innych części
+// - wymianę paczek z czasem: (tura, nadawca, odbiorca, ID paczki)
+// - cofanie: paczka z tury już wykonanej (spóźniona) lub antywiadomość
+//   dla przetworzonej paczki przywraca zapisany stan części i odtwarza
+//   tury do punktu cofnięcia; paczki wysłane w turach po punkcie
+//   cofnięcia są odwoływane antywiadomościami
+// - GVT (najmniejszy możliwy czas cofnięcia): okresowa runda wszystkich
+//   wątków; zapisy stanu, wejścia i wyjścia sprzed GVT są usuwane
+//
+// Paczka nadawcy w turze t zależy tylko od stanu części po turze t - 1,
+// więc cofnięcie do t odwołuje tylko paczki z tur > t (łańcuch cofnięć
+// między częściami zawsze przesuwa się do przodu w czasie).
+// ID paczek z ramp wynikają z numeru tury (reguła (t - 1) % interval == 0),
+// więc części nie współdzielą rejestru ID w trakcie przebiegu.
+//
+// Wynik jest identyczny z simulate() / simulate_event_driven().
+// ==============================
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Factory/factory.hpp"
+
+// =======================================================
+// Opcje i liczniki
+// =======================================================
+
+struct OptimisticOptions {
+    std::size_t parts = 2;          // wątki (części grafu)
+    double balance = 0.1;           // jak w partition_factory
+    TimeOffset state_interval = 8;  // co ile tur zapis stanu części
+    TimeOffset gvt_interval = 32;   // tury części między rundami GVT
+    TimeOffset window = 256;        // maks. wyprzedzenie GVT (0 -> bez limitu)
+};
+
+// Liczniki jednej części
+struct RollbackStats {
+    std::uint64_t turns = 0;                // wykonane tury (bez odtwarzania)
+    std::uint64_t rolled_back_turns = 0;    // tury cofnięte
+    std::uint64_t coast_turns = 0;          // tury odtworzone od zapisu do punktu cofnięcia
+    std::uint64_t rollbacks = 0;            // wszystkie cofnięcia
+    std::uint64_t straggler_rollbacks = 0;  // ...przez spóźnioną paczkę
+    std::uint64_t anti_rollbacks = 0;       // ...przez antywiadomość
+    std::uint64_t messages = 0;             // paczki wysłane do innych części
+    std::uint64_t anti_messages = 0;        // odwołania paczek
+    std::uint64_t annihilated = 0;          // paczki odwołane przed przetworzeniem
+    std::uint64_t states_saved = 0;
+    std::uint64_t gvt_rounds = 0;
+};
+
+// =======================================================
+// Funkcja simulate_optimistic()
+// =======================================================
+//
+// Jak simulate(f, d, rf), ale rf jest wywoływana raz, po turze d
+// (stany części w turach pośrednich nie są spójne).
+// Wymaga generatorów FixedProbability / RandomStream (zapis stanu nadawcy).
+// Kolejki robotników bez limitu (queue-capacity), rampy ze stałym odstępem
+// dostaw, bez zapisu dostaw (czasy obróbki mogą być losowe).
+// Zwraca liczniki części.
+//
+std::vector<RollbackStats> simulate_optimistic(
+    Factory& f,
+    TimeOffset d,
+    std::function<void(Factory&, Time)> rf,
+    const OptimisticOptions& options = {}
+);
@@ -0,0 +1,107 @@
+#include "WorkerLayout.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// =======================================================
+// Kompilacja układu
+// =======================================================
+
+WorkerLayout::WorkerLayout(Factory& f) : factory_(f) {
+    // obraz i zbiory fabryki gotowe przed podpięciem (przebudowa nadpisałaby zgłoszenia)
+    f.snapshot();
+
+    for (auto it = f.worker_begin(); it != f.worker_end(); ++it) {
+        if (it->is_multi_server()) {
+            multi_.push_back(&(*it));
+            continue;
+        }
+        workers_.push_back(&(*it));
+        busy_.push_back(it->is_processing() ? -1 : 0);
+        start_.push_back(it->get_package_processing_start_time());
+        duration_.push_back(it->get_processing_duration());
+    }
+    done_.assign(workers_.size(), 0);
+
+    waiting_.reset(workers_.size());
+    for (std::size_t i = 0; i < workers_.size(); ++i) {
+        workers_[i]->attach_worker_set(&waiting_, i);
+        if (!busy_[i] && !workers_[i]->get_queue()->empty()) {
+            waiting_.insert(i);
+        }
+    }
+}
+
+// zbiory aktywne fabryki powstaną od nowa z bieżącego stanu
+WorkerLayout::~WorkerLayout() {
+    factory_.invalidate();
+}
+
+std::size_t WorkerLayout::size() const {
+    return workers_.size() + multi_.size();
+}
+
+// =======================================================
+// Praca robotników
+// =======================================================
+
+void WorkerLayout::do_work(Time t) {
+    const std::size_t n = workers_.size();
+
+    // 1️⃣ Wolni robotnicy pobierają paczki z kolejek
+    // (tylko zgłoszeni; zajęci wrócą do zbioru po zakończeniu obróbki)
+    waiting_.drain_sorted(batch_);
+    for (std::size_t i : batch_) {
+        if (!busy_[i] && workers_[i]->start_processing(t)) {
+            busy_[i] = -1;
+            start_[i] = t;
+            duration_[i] = workers_[i]->get_processing_duration();
+        }
+    }
+
+    // 2️⃣ Kto kończy w tej turze (wektorowo)
+    find_finished(t);
+
+    // 3️⃣ Skończone paczki trafiają do buforów nadawców
+    // (zajęty bufor -> paczka czeka w obróbce, jak w Worker::do_work)
+    for (std::size_t i = 0; i < n; ++i) {
+        if (done_[i] && !workers_[i]->has_package()) {
+            workers_[i]->finish_processing();
+            busy_[i] = 0;
+            if (!workers_[i]->get_queue()->empty()) {
+                waiting_.insert(i);
+            }
+        }
+    }
+
+    for (Worker* w : multi_) {
+        w->do_work(t);
+    }
+}
+
+void WorkerLayout::find_finished(Time t) {
+    const std::size_t n = workers_.size();
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    // t - start + 1 >= duration  <=>  !(duration > t + 1 - start)
+    const __m128i next = _mm_set1_epi32(t + 1);
+    for (; i + 4 <= n; i += 4) {
+        __m128i busy = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&busy_[i]));
+        __m128i start = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&start_[i]));
+        __m128i dur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&duration_[i]));
+
+        __m128i elapsed = _mm_sub_epi32(next, start);
+        __m128i not_yet = _mm_cmpgt_epi32(dur, elapsed);
+        __m128i done = _mm_andnot_si128(not_yet, busy);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&done_[i]), done);
+    }
+#endif
+
+    // reszta (lub całość bez SSE2)
+    for (; i < n; ++i) {
+        done_[i] = (busy_[i] && t - start_[i] + 1 >= duration_[i]) ? -1 : 0;
+    }
+}
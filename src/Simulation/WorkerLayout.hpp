@@ -0,0 +1,64 @@
+#pragma once
+
+// ==============================
+// WorkerLayout.hpp
+// ==============================
+// Skompilowany układ stanu robotników (struct-of-arrays)
+//
+// Odpowiada za:
+// - przechowywanie czasów pracy robotników w równoległych tablicach
+// - sprawdzanie warunku „skończył w tej turze”
+//   (t - start + 1 >= duration) wektorowo (SSE2) dla wielu robotników naraz
+//
+// Wynik jest taki sam jak Factory::do_work (Worker::do_work dla każdego
+// robotnika). Układ trzeba skompilować ponownie po zmianie listy robotników.
+// Robotnicy wielostanowiskowi (k > 1 lub B > 1) są poza tablicami
+// i pracują przez Worker::do_work.
+//
+// Wolni robotnicy z paczkami w kolejce są w zbiorze waiting_ (zgłoszenia
+// przyjęć paczek), więc pobieranie paczek nie przechodzi po wszystkich
+// wolnych robotnikach. Na czas życia układu robotnicy z tablic zgłaszają
+// się do układu zamiast do fabryki; destruktor wymusza ponowne
+// wyznaczenie zbiorów aktywnych fabryki.
+// ==============================
+
+#include <cstdint>
+#include <vector>
+
+#include "Factory/factory.hpp"
+
+// =======================================================
+// WorkerLayout
+// =======================================================
+
+class WorkerLayout {
+public:
+    explicit WorkerLayout(Factory& f);
+    ~WorkerLayout();
+
+    WorkerLayout(const WorkerLayout&) = delete;
+    WorkerLayout& operator=(const WorkerLayout&) = delete;
+
+    // Odpowiednik Factory::do_work(t)
+    void do_work(Time t);
+
+    std::size_t size() const;
+
+private:
+    // Wektorowe wyznaczenie done_[i] = busy_[i] && t - start_[i] + 1 >= duration_[i]
+    void find_finished(Time t);
+
+    Factory& factory_;
+    std::vector<Worker*> workers_;
+    std::vector<Worker*> multi_;         // is_multi_server()
+
+    // stan czasowy (indeks = pozycja w workers_)
+    std::vector<std::int32_t> busy_;     // 0 lub -1 (maska)
+    std::vector<std::int32_t> start_;
+    std::vector<std::int32_t> duration_;
+    std::vector<std::int32_t> done_;     // 0 lub -1 (maska)
+
+    // wolni robotnicy, którzy mogą mieć paczki w kolejce
+    ActiveSet waiting_;
+    std::vector<std::size_t> batch_;
+};
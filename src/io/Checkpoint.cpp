@@ -0,0 +1,470 @@
+#include "Checkpoint.hpp"
+#include "Parser.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// =======================================================
+// Zapis / odczyt wartości (little-endian)
+// =======================================================
+
+static const char CHECKPOINT_MAGIC[4] = {'N', 'S', 'C', 'K'};
+static const std::uint32_t CHECKPOINT_VERSION = 1;
+
+static void write_u64(std::ostream& os, std::uint64_t v) {
+    char buf[8];
+    for (int i = 0; i < 8; ++i) {
+        buf[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+    }
+    os.write(buf, 8);
+}
+
+static std::uint64_t read_u64(std::istream& is) {
+    unsigned char buf[8];
+    if (!is.read(reinterpret_cast<char*>(buf), 8)) {
+        throw std::runtime_error("Truncated checkpoint");
+    }
+    std::uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) {
+        v = (v << 8) | buf[i];
+    }
+    return v;
+}
+
+static void write_i64(std::ostream& os, std::int64_t v) {
+    write_u64(os, static_cast<std::uint64_t>(v));
+}
+
+static std::int64_t read_i64(std::istream& is) {
+    return static_cast<std::int64_t>(read_u64(is));
+}
+
+static void write_f64(std::ostream& os, double v) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &v, sizeof bits);
+    write_u64(os, bits);
+}
+
+static double read_f64(std::istream& is) {
+    std::uint64_t bits = read_u64(is);
+    double v;
+    std::memcpy(&v, &bits, sizeof v);
+    return v;
+}
+
+static void write_string(std::ostream& os, const std::string& s) {
+    write_u64(os, s.size());
+    os.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+static std::string read_string(std::istream& is) {
+    std::string s(static_cast<std::size_t>(read_u64(is)), '\0');
+    if (!is.read(&s[0], static_cast<std::streamsize>(s.size()))) {
+        throw std::runtime_error("Truncated checkpoint");
+    }
+    return s;
+}
+
+static void write_ids(std::ostream& os, const std::vector<ElementID>& ids) {
+    write_u64(os, ids.size());
+    for (ElementID id : ids) {
+        write_i64(os, id);
+    }
+}
+
+static std::vector<ElementID> read_ids(std::istream& is) {
+    std::vector<ElementID> ids(static_cast<std::size_t>(read_u64(is)));
+    for (auto& id : ids) {
+        id = static_cast<ElementID>(read_i64(is));
+    }
+    return ids;
+}
+
+// Paczka: ID, priorytet i termin
+static void write_package(std::ostream& os, const Package& p) {
+    write_i64(os, p.getID());
+    write_i64(os, p.get_priority());
+    write_i64(os, p.get_deadline());
+}
+
+static Package read_package(std::istream& is) {
+    ElementID id = static_cast<ElementID>(read_i64(is));
+    int priority = static_cast<int>(read_i64(is));
+    Time deadline = static_cast<Time>(read_i64(is));
+    return Package::restore(id, priority, deadline);
+}
+
+template <typename Iterator>
+static void write_packages(std::ostream& os, Iterator first, Iterator last) {
+    write_u64(os, std::distance(first, last));
+    for (; first != last; ++first) {
+        write_package(os, *first);
+    }
+}
+
+static std::vector<Package> read_packages(std::istream& is) {
+    std::vector<Package> packages;
+    for (std::uint64_t n = read_u64(is); n > 0; --n) {
+        packages.push_back(read_package(is));
+    }
+    return packages;
+}
+
+// =======================================================
+// Stan nadawcy (bufor + generator)
+// =======================================================
+
+enum class GeneratorKind : std::uint64_t { FIXED = 0, STREAM = 1 };
+
+static void save_sender(const PackageSender& sender, std::ostream& os) {
+    write_u64(os, sender.has_package() ? 1 : 0);
+    if (sender.has_package()) {
+        write_package(os, sender.get_package());
+    }
+
+    const auto& pg = sender.receiver_preferences.get_probability_generator();
+    if (auto fixed = pg.target<FixedProbability>()) {
+        write_u64(os, static_cast<std::uint64_t>(GeneratorKind::FIXED));
+        write_f64(os, fixed->value);
+    } else if (auto stream = pg.target<RandomStream>()) {
+        write_u64(os, static_cast<std::uint64_t>(GeneratorKind::STREAM));
+        write_u64(os, stream->get_seed());
+        write_u64(os, stream->get_position());
+    } else {
+        throw std::logic_error("Probability generator cannot be checkpointed");
+    }
+
+    write_i64(os, sender.get_blocked_turns());
+}
+
+// apply == false -> rekord jest tylko odczytywany (składanie części)
+static void load_sender(PackageSender& sender, std::istream& is, bool apply) {
+    if (read_u64(is)) {
+        Package p = read_package(is);
+        if (apply) sender.push_package(std::move(p));
+    }
+
+    auto& pg = sender.receiver_preferences.get_probability_generator();
+    auto kind = static_cast<GeneratorKind>(read_u64(is));
+    if (kind == GeneratorKind::FIXED) {
+        double value = read_f64(is);
+        if (apply) pg = FixedProbability{value};
+    } else if (kind == GeneratorKind::STREAM) {
+        std::uint64_t seed = read_u64(is);
+        std::uint64_t position = read_u64(is);
+        if (apply) pg = RandomStream(seed, position);
+    } else {
+        throw std::runtime_error("Unknown generator in checkpoint");
+    }
+
+    long long blocked = read_i64(is);
+    if (apply) sender.restore_blocked_turns(blocked);
+}
+
+// =======================================================
+// Zapis checkpointu
+// =======================================================
+
+void IO::save_checkpoint(const Factory& factory, Time t, std::ostream& os) {
+    os.write(CHECKPOINT_MAGIC, sizeof CHECKPOINT_MAGIC);
+    write_u64(os, CHECKPOINT_VERSION);
+    write_i64(os, t);
+
+    std::ostringstream topology;
+    save_factory_structure(factory, topology);
+    write_string(os, topology.str());
+
+    std::vector<ElementID> assigned, freed;
+    ElementID prefix;
+    Package::save_registry(assigned, freed, prefix);
+    write_ids(os, assigned);
+    write_ids(os, freed);
+    write_i64(os, prefix);
+
+    // RAMPY
+    write_u64(os, std::distance(factory.ramp_cbegin(), factory.ramp_cend()));
+    for (auto it = factory.ramp_cbegin(); it != factory.ramp_cend(); ++it) {
+        write_i64(os, it->get_id());
+        save_sender(*it, os);
+        write_i64(os, it->get_lost_deliveries());
+        write_i64(os, it->next_delivery_time(t + 1));
+        write_u64(os, it->get_delivery_stream().get_position());
+        if (it->get_trace()) {
+            write_u64(os, it->get_trace()->get_offset());
+            write_u64(os, it->get_pending_arrivals().size());
+            for (const TraceRecord& r : it->get_pending_arrivals()) {
+                write_i64(os, r.turn);
+                write_u64(os, r.count);
+            }
+        }
+    }
+
+    // ROBOTNICY
+    write_u64(os, std::distance(factory.worker_cbegin(), factory.worker_cend()));
+    for (auto it = factory.worker_cbegin(); it != factory.worker_cend(); ++it) {
+        write_i64(os, it->get_id());
+        write_packages(os, it->cbegin(), it->cend());
+
+        write_u64(os, it->is_processing() ? 1 : 0);
+        if (it->is_processing()) {
+            write_package(os, it->get_processing_package());
+            write_i64(os, it->get_package_processing_start_time());
+            write_i64(os, it->get_processing_duration());
+        }
+        write_u64(os, it->get_in_flight().size());
+        for (const InFlightPackage& p : it->get_in_flight()) {
+            write_package(os, p.package);
+            write_i64(os, p.start);
+            write_i64(os, p.duration);
+        }
+        write_packages(os, it->get_finished().cbegin(), it->get_finished().cend());
+        save_sender(*it, os);
+
+        const WorkerStats& st = it->get_stats();
+        write_u64(os, st.received);
+        write_u64(os, st.processed);
+        write_i64(os, st.busy_turns);
+        write_i64(os, st.arrival_time_sum);
+        write_i64(os, st.departure_time_sum);
+        write_u64(os, st.rejected);
+        write_u64(os, it->get_processing_stream().get_position());
+    }
+
+    // MAGAZYNY
+    write_u64(os, std::distance(factory.storehouse_cbegin(), factory.storehouse_cend()));
+    for (auto it = factory.storehouse_cbegin(); it != factory.storehouse_cend(); ++it) {
+        write_i64(os, it->get_id());
+        write_packages(os, it->cbegin(), it->cend());
+
+        const DeadlineStats& ds = it->get_deadline_stats();
+        write_u64(os, ds.due);
+        write_u64(os, ds.late);
+        write_i64(os, ds.tardiness_sum);
+        write_i64(os, ds.max_tardiness);
+
+        auto summary = dynamic_cast<const PackageSummary*>(it->get_stockpile());
+        if (summary) {
+            write_u64(os, summary->size());
+            write_i64(os, summary->get_current_time());
+            write_i64(os, summary->get_bucket_width());
+            const auto& hist = summary->get_histogram();
+            write_u64(os, hist.size());
+            for (std::size_t n : hist) {
+                write_u64(os, n);
+            }
+            write_string(os, summary->get_rng_state());
+        }
+    }
+}
+
+// =======================================================
+// Odtworzenie checkpointu
+// =======================================================
+
+struct CheckpointHeader {
+    Time t;
+    std::string topology;
+    std::vector<ElementID> assigned;
+    std::vector<ElementID> freed;
+    ElementID prefix;
+};
+
+static CheckpointHeader read_header(std::istream& is) {
+    char magic[sizeof CHECKPOINT_MAGIC];
+    if (!is.read(magic, sizeof magic) ||
+        std::memcmp(magic, CHECKPOINT_MAGIC, sizeof magic) != 0) {
+        throw std::runtime_error("Not a checkpoint");
+    }
+
+    if (read_u64(is) != CHECKPOINT_VERSION) {
+        throw std::runtime_error("Unsupported checkpoint version");
+    }
+
+    CheckpointHeader h;
+    h.t = static_cast<Time>(read_i64(is));
+    h.topology = read_string(is);
+    h.assigned = read_ids(is);
+    h.freed = read_ids(is);
+    h.prefix = static_cast<ElementID>(read_i64(is));
+    return h;
+}
+
+// Stany węzłów; keep(rodzaj, id) == false -> rekord pomijany
+static void read_nodes(
+    Factory& factory,
+    std::istream& is,
+    const std::function<bool(IO::CheckpointNode, ElementID)>& keep
+) {
+    // RAMPY
+    for (std::uint64_t n = read_u64(is); n > 0; --n) {
+        ElementID id = static_cast<ElementID>(read_i64(is));
+        auto ramp = std::find_if(factory.ramp_begin(), factory.ramp_end(),
+            [id](const Ramp& r) { return r.get_id() == id; });
+        if (ramp == factory.ramp_end()) {
+            throw std::runtime_error("Checkpoint ramp not in topology");
+        }
+        const bool apply = keep(IO::CheckpointNode::RAMP, id);
+        load_sender(*ramp, is, apply);
+        long long lost = read_i64(is);
+        if (apply) ramp->restore_lost_deliveries(lost);
+        Time next = static_cast<Time>(read_i64(is));
+        std::uint64_t position = read_u64(is);
+        if (apply) ramp->restore_delivery_schedule(next, position);
+        if (ramp->get_trace()) {
+            std::uint64_t offset = read_u64(is);
+            std::deque<TraceRecord> pending;
+            for (std::uint64_t k = read_u64(is); k > 0; --k) {
+                Time turn = static_cast<Time>(read_i64(is));
+                pending.push_back(TraceRecord{turn, read_u64(is)});
+            }
+            if (apply) ramp->restore_trace(offset, std::move(pending));
+        }
+    }
+
+    // ROBOTNICY
+    for (std::uint64_t n = read_u64(is); n > 0; --n) {
+        ElementID id = static_cast<ElementID>(read_i64(is));
+        auto worker = std::find_if(factory.worker_begin(), factory.worker_end(),
+            [id](const Worker& w) { return w.get_id() == id; });
+        if (worker == factory.worker_end()) {
+            throw std::runtime_error("Checkpoint worker not in topology");
+        }
+        const bool apply = keep(IO::CheckpointNode::WORKER, id);
+
+        for (Package& p : read_packages(is)) {
+            if (apply) worker->receive_package(std::move(p));
+        }
+        if (read_u64(is)) {
+            Package p = read_package(is);
+            Time start = static_cast<Time>(read_i64(is));
+            TimeOffset duration = static_cast<TimeOffset>(read_i64(is));
+            if (apply) worker->restore_processing(std::move(p), start, duration);
+        }
+        for (std::uint64_t k = read_u64(is); k > 0; --k) {
+            Package p = read_package(is);
+            Time start = static_cast<Time>(read_i64(is));
+            TimeOffset duration = static_cast<TimeOffset>(read_i64(is));
+            if (apply) worker->restore_in_flight(std::move(p), start, duration);
+        }
+        for (Package& p : read_packages(is)) {
+            if (apply) worker->restore_finished(std::move(p));
+        }
+        load_sender(*worker, is, apply);
+
+        // po paczkach: receive_package zmienia liczniki
+        WorkerStats st;
+        st.received = static_cast<std::size_t>(read_u64(is));
+        st.processed = static_cast<std::size_t>(read_u64(is));
+        st.busy_turns = read_i64(is);
+        st.arrival_time_sum = read_i64(is);
+        st.departure_time_sum = read_i64(is);
+        st.rejected = static_cast<std::size_t>(read_u64(is));
+        if (apply) worker->restore_stats(st);
+
+        std::uint64_t position = read_u64(is);
+        if (apply) worker->restore_processing_position(position);
+    }
+
+    // MAGAZYNY
+    for (std::uint64_t n = read_u64(is); n > 0; --n) {
+        ElementID id = static_cast<ElementID>(read_i64(is));
+        auto store = std::find_if(factory.storehouse_begin(), factory.storehouse_end(),
+            [id](const Storehouse& s) { return s.get_id() == id; });
+        if (store == factory.storehouse_end()) {
+            throw std::runtime_error("Checkpoint storehouse not in topology");
+        }
+        const bool apply = keep(IO::CheckpointNode::STOREHOUSE, id);
+
+        std::vector<Package> packages = read_packages(is);
+        DeadlineStats ds;
+        ds.due = static_cast<std::size_t>(read_u64(is));
+        ds.late = static_cast<std::size_t>(read_u64(is));
+        ds.tardiness_sum = read_i64(is);
+        ds.max_tardiness = read_i64(is);
+
+        auto summary = dynamic_cast<PackageSummary*>(store->get_stockpile());
+        if (!summary) {
+            for (Package& p : packages) {
+                if (apply) store->receive_package(std::move(p));
+            }
+            // po paczkach: receive_package zmienia liczniki
+            if (apply) store->restore_deadline_stats(ds);
+            continue;
+        }
+
+        std::size_t count = static_cast<std::size_t>(read_u64(is));
+        Time current = static_cast<Time>(read_i64(is));
+        TimeOffset width = static_cast<TimeOffset>(read_i64(is));
+        std::vector<std::size_t> hist(static_cast<std::size_t>(read_u64(is)));
+        for (auto& h : hist) {
+            h = static_cast<std::size_t>(read_u64(is));
+        }
+        std::string rng = read_string(is);
+        if (!apply) continue;
+
+        summary->restore_state(count, current, width, hist, std::move(packages), rng);
+        store->restore_deadline_stats(ds);
+    }
+}
+
+Factory IO::load_checkpoint(std::istream& is, Time& t) {
+    CheckpointHeader h = read_header(is);
+    t = h.t;
+
+    std::istringstream topology(h.topology);
+    Factory factory = load_factory_structure(topology);
+
+    read_nodes(factory, is,
+        [](CheckpointNode, ElementID) { return true; });
+
+    // na końcu: paczki-zaślepki utworzone razem z węzłami nie zmieniają rejestru
+    Package::load_registry(h.assigned, h.freed, h.prefix);
+    return factory;
+}
+
+// =======================================================
+// Składanie checkpointów części
+// =======================================================
+
+Factory IO::merge_checkpoints(
+    const std::vector<std::string>& parts,
+    const std::function<std::size_t(CheckpointNode, ElementID)>& owner,
+    Time& t
+) {
+    if (parts.empty()) {
+        throw std::invalid_argument("No checkpoint parts to merge");
+    }
+
+    std::vector<std::istringstream> streams;
+    std::vector<CheckpointHeader> headers;
+    for (const std::string& part : parts) {
+        streams.emplace_back(part);
+        headers.push_back(read_header(streams.back()));
+
+        const CheckpointHeader& first = headers.front();
+        const CheckpointHeader& h = headers.back();
+        if (h.t != first.t || h.topology != first.topology ||
+            h.assigned != first.assigned || h.freed != first.freed ||
+            h.prefix != first.prefix) {
+            throw std::runtime_error("Checkpoint parts do not match");
+        }
+    }
+    t = headers.front().t;
+
+    std::istringstream topology(headers.front().topology);
+    Factory factory = load_factory_structure(topology);
+
+    for (std::size_t k = 0; k < parts.size(); ++k) {
+        read_nodes(factory, streams[k],
+            [&owner, k](CheckpointNode node, ElementID id) { return owner(node, id) == k; });
+    }
+
+    Package::load_registry(headers.front().assigned, headers.front().freed, headers.front().prefix);
+    return factory;
+}
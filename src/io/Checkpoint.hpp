@@ -0,0 +1,59 @@
+#pragma once
+
+// ==============================
+// Checkpoint.hpp
+// ==============================
+// Zapis i odtworzenie pełnego stanu symulacji (format binarny)
+//
+// Checkpoint zawiera:
+// - topologię (jak save_factory_structure)
+// - zawartość i kolejność kolejek robotników i magazynów
+// - paczki w obróbce i czasy rozpoczęcia pracy
+// - bufory nadawców
+// - pozycje strumieni RandomStream w preferencjach odbiorców
+// - liczniki blokad nadawców i WorkerStats robotników
+// - paczki w obróbce i czekające na wyjście robotników wielostanowiskowych
+// - odmowy pełnych kolejek i utracone dostawy ramp
+// - priorytety i terminy paczek, spóźnienia w magazynach
+// - pozycje strumieni czasów losowych, terminy dostaw ramp i czasy
+//   trwających obróbek
+// - pozycje w plikach zapisów dostaw i paczki czekające na rampach
+//   z zapisem (plik zapisu musi być dostępny przy odczycie)
+// - stan rejestru ID paczek
+//
+// Po odtworzeniu symulacja kontynuowana od tury t + 1
+// (simulate_range) przebiega identycznie jak bez przerwy.
+// Liczby zapisywane są jako little-endian niezależnie od platformy.
+// ==============================
+
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Factory/factory.hpp"
+
+namespace IO {
+
+    // Zapisuje stan fabryki po zakończeniu tury t
+    void save_checkpoint(const Factory& factory, Time t, std::ostream& os);
+
+    // Odtwarza fabrykę; t <- tura, po której zapisano checkpoint.
+    // Rejestr ID paczek jest nadpisywany, więc poprzednia fabryka
+    // nie powinna już tworzyć nowych paczek.
+    Factory load_checkpoint(std::istream& is, Time& t);
+
+    // Rodzaj węzła przy składaniu checkpointów
+    enum class CheckpointNode { RAMP, WORKER, STOREHOUSE };
+
+    // Składa fabrykę z checkpointów części tej samej symulacji
+    // (ta sama tura, topologia i rejestr ID): stan węzła pochodzi
+    // z części owner(rodzaj, id). Stan pozostałych węzłów części jest pomijany.
+    Factory merge_checkpoints(
+        const std::vector<std::string>& parts,
+        const std::function<std::size_t(CheckpointNode, ElementID)>& owner,
+        Time& t
+    );
+}
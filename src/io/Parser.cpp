@@ -1,5 +1,6 @@
 #include "Parser.hpp"
 
+#include <cstdio>
 #include <sstream>
 #include <vector>
 #include <stdexcept>
@@ -20,6 +21,194 @@ static std::vector<std::string> split(const std::string& line) {
     return tokens;
 }
 
+// Opcjonalny klucz routing-seed=N -> losowy wybór odbiorcy ze strumienia RandomStream
+// (bez klucza generator stały 0.5)
+template <typename Spec>
+static void read_routing_seed(Spec& spec, const ParsedLineData& data) {
+    auto it = data.parameters.find("routing-seed");
+    if (it != data.parameters.end()) {
+        spec.seeded = true;
+        spec.routing_seed = std::stoull(it->second);
+    }
+}
+
+template <typename Spec>
+static void apply_routing_seed(PackageSender& sender, const Spec& spec) {
+    if (spec.seeded) {
+        sender.receiver_preferences =
+            ReceiverPreferences(RandomStream(spec.routing_seed));
+    }
+}
+
+static void write_routing_seed(const PackageSender& sender, std::ostream& os) {
+    auto stream = sender.receiver_preferences
+        .get_probability_generator().target<RandomStream>();
+    if (stream) {
+        os << " routing-seed=" << stream->get_seed();
+    }
+}
+
+// Opcjonalny klucz time-seed=N -> ziarno strumienia czasów losowych
+// (bez klucza ziarno pochodne od rodzaju i ID węzła)
+template <typename Spec>
+static void read_time_seed(Spec& spec, const ParsedLineData& data) {
+    auto it = data.parameters.find("time-seed");
+    if (it != data.parameters.end()) {
+        spec.time_seeded = true;
+        spec.time_seed = std::stoull(it->second);
+    }
+}
+
+template <typename Spec>
+static DurationStream make_duration_stream(const DurationDistribution& d, const Spec& spec, bool worker) {
+    if (d.is_fixed()) {
+        return DurationStream(d.nominal());
+    }
+    std::uint64_t seed = spec.time_seeded
+        ? spec.time_seed
+        : RandomStream::derive_seed(worker ? 1 : 0, static_cast<std::uint64_t>(spec.id));
+    return DurationStream(d, seed);
+}
+
+// Klucze zapisu dostaw: trace=PLIK [trace-scale=S] [trace-origin=T]
+// (ścieżka bez spacji; tura = (znacznik - T) / S + 1)
+static void read_trace_source(FactoryDraft::RampSpec& spec, const ParsedLineData& data) {
+    spec.traced = true;
+    spec.trace.path = data.parameters.at("trace");
+
+    auto sc = data.parameters.find("trace-scale");
+    if (sc != data.parameters.end()) {
+        spec.trace.scale = std::stoll(sc->second);
+        if (spec.trace.scale <= 0) {
+            throw std::logic_error("Invalid trace-scale value");
+        }
+    }
+    auto og = data.parameters.find("trace-origin");
+    if (og != data.parameters.end()) {
+        spec.trace.has_origin = true;
+        spec.trace.origin = std::stoll(og->second);
+    }
+}
+
+static void write_trace_source(const TraceReader& trace, std::ostream& os) {
+    const TraceSource& source = trace.get_source();
+    os << " trace=" << source.path;
+    if (source.scale != 1) os << " trace-scale=" << source.scale;
+    os << " trace-origin=" << source.origin;
+}
+
+static std::vector<std::string> split_on(const std::string& text, char sep) {
+    std::vector<std::string> parts;
+    std::istringstream iss(text);
+    std::string part;
+
+    while (std::getline(iss, part, sep)) {
+        parts.push_back(part);
+    }
+    return parts;
+}
+
+// Czas w turach albo rozkład:
+//   N                  stały
+//   exp:M              wykładniczy o średniej M
+//   uniform:L:H        jednostajny całkowity L..H
+//   lognormal:MU:S     exp(N(MU, S^2))
+//   empirical:V:W,...  wartości V z wagami W
+static DurationDistribution parse_duration(const std::string& text) {
+    auto colon = text.find(':');
+    if (colon == std::string::npos) {
+        return DurationDistribution(std::stoi(text));
+    }
+
+    const std::string kind = text.substr(0, colon);
+    const std::string rest = text.substr(colon + 1);
+    std::vector<std::string> args = split_on(rest, ':');
+
+    if (kind == "exp" && args.size() == 1) {
+        return DurationDistribution::exponential(std::stod(args[0]));
+    }
+    if (kind == "uniform" && args.size() == 2) {
+        return DurationDistribution::uniform(std::stoi(args[0]), std::stoi(args[1]));
+    }
+    if (kind == "lognormal" && args.size() == 2) {
+        return DurationDistribution::lognormal(std::stod(args[0]), std::stod(args[1]));
+    }
+    if (kind == "empirical") {
+        std::vector<TimeOffset> values;
+        std::vector<double> weights;
+        for (const std::string& entry : split_on(rest, ',')) {
+            std::vector<std::string> vw = split_on(entry, ':');
+            if (vw.size() != 2) {
+                throw std::logic_error("Invalid empirical table entry");
+            }
+            values.push_back(std::stoi(vw[0]));
+            weights.push_back(std::stod(vw[1]));
+        }
+        return DurationDistribution::empirical(std::move(values), std::move(weights));
+    }
+    throw std::logic_error("Unknown duration distribution");
+}
+
+// Liczba zmiennoprzecinkowa w najkrótszej postaci, która wczytuje się bez zmian
+static std::string format_number(double x) {
+    char buf[32];
+    std::snprintf(buf, sizeof buf, "%.15g", x);
+    if (std::stod(buf) != x) {
+        std::snprintf(buf, sizeof buf, "%.17g", x);
+    }
+    return buf;
+}
+
+static std::string duration_spec(const DurationDistribution& d) {
+    switch (d.get_kind()) {
+        case DurationKind::FIXED:
+            return std::to_string(d.nominal());
+        case DurationKind::EXPONENTIAL:
+            return "exp:" + format_number(d.get_first());
+        case DurationKind::UNIFORM:
+            return "uniform:" + format_number(d.get_first()) + ":" + format_number(d.get_second());
+        case DurationKind::LOGNORMAL:
+            return "lognormal:" + format_number(d.get_first()) + ":" + format_number(d.get_second());
+        case DurationKind::EMPIRICAL: {
+            std::string text = "empirical:";
+            for (std::size_t i = 0; i < d.get_values().size(); ++i) {
+                if (i > 0) text += ",";
+                text += std::to_string(d.get_values()[i]) + ":" + format_number(d.get_weights()[i]);
+            }
+            return text;
+        }
+    }
+    return std::to_string(d.nominal());
+}
+
+static void write_duration(const DurationStream& stream, const char* key, std::ostream& os) {
+    os << " " << key << "=" << duration_spec(stream.get_distribution());
+}
+
+static void write_time_seed(const DurationStream& stream, std::ostream& os) {
+    if (!stream.get_distribution().is_fixed()) {
+        os << " time-seed=" << stream.get_seed();
+    }
+}
+
+static PackageQueueType parse_queue_type(const std::string& name) {
+    if (name == "FIFO") return PackageQueueType::FIFO;
+    if (name == "LIFO") return PackageQueueType::LIFO;
+    if (name == "PRIORITY") return PackageQueueType::PRIORITY;
+    if (name == "EDF") return PackageQueueType::EDF;
+    throw std::logic_error("Unknown queue type");
+}
+
+static const char* queue_type_name(PackageQueueType type) {
+    switch (type) {
+        case PackageQueueType::FIFO:     return "FIFO";
+        case PackageQueueType::LIFO:     return "LIFO";
+        case PackageQueueType::PRIORITY: return "PRIORITY";
+        case PackageQueueType::EDF:      return "EDF";
+    }
+    return "FIFO";
+}
+
 // =======================================================
 // Parsowanie jednej linii
 // =======================================================
@@ -66,7 +255,11 @@ ParsedLineData IO::parse_line(const std::string& line) {
 // =======================================================
 
 Factory IO::load_factory_structure(std::istream& is) {
-    Factory factory;
+    return build_factory(load_factory_draft(is));
+}
+
+FactoryDraft IO::load_factory_draft(std::istream& is) {
+    FactoryDraft draft;
     std::string line;
 
     while (std::getline(is, line)) {
@@ -81,88 +274,196 @@ Factory IO::load_factory_structure(std::istream& is) {
         // RAMP
         // ---------------------------------------------------
         if (data.type == ElementType::RAMP) {
-            ElementID id = std::stoi(data.parameters.at("id"));
-            TimeOffset di = std::stoi(data.parameters.at("delivery-interval"));
+            FactoryDraft::RampSpec spec;
+            spec.id = std::stoi(data.parameters.at("id"));
+
+            // Dostawy z pliku zapisu albo odstęp (stały lub losowy)
+            auto tr = data.parameters.find("trace");
+            if (tr != data.parameters.end()) {
+                if (data.parameters.count("delivery-interval")) {
+                    throw std::logic_error("RAMP takes either delivery-interval or trace");
+                }
+                read_trace_source(spec, data);
+            } else {
+                spec.di = parse_duration(data.parameters.at("delivery-interval"));
+            }
 
-            factory.add_ramp(Ramp(id, di));
+            // Opcjonalne atrybuty paczek rampy (kolejki PRIORITY / EDF)
+            auto pr = data.parameters.find("priority");
+            if (pr != data.parameters.end()) {
+                spec.priority = std::stoi(pr->second);
+            }
+            auto dl = data.parameters.find("deadline");
+            if (dl != data.parameters.end()) {
+                spec.deadline = std::stoi(dl->second);
+                if (spec.deadline < 0) {
+                    throw std::logic_error("Invalid deadline value");
+                }
+            }
+            read_routing_seed(spec, data);
+            read_time_seed(spec, data);
+            draft.ramps.push_back(spec);
         }
 
         // ---------------------------------------------------
         // WORKER
         // ---------------------------------------------------
         else if (data.type == ElementType::WORKER) {
-            ElementID id = std::stoi(data.parameters.at("id"));
-            TimeOffset pd = std::stoi(data.parameters.at("processing-time"));
-
-            std::string q = data.parameters.at("queue-type");
-            PackageQueueType qt =
-                (q == "FIFO") ? PackageQueueType::FIFO : PackageQueueType::LIFO;
+            FactoryDraft::WorkerSpec spec;
+            spec.id = std::stoi(data.parameters.at("id"));
+            spec.pt = parse_duration(data.parameters.at("processing-time"));
+
+            spec.qt = parse_queue_type(data.parameters.at("queue-type"));
+
+            // Opcjonalnie kilka stanowisk (servers=k) i obróbka partiami (batch=B)
+            auto count = [&data](const std::string& key) -> std::size_t {
+                auto it = data.parameters.find(key);
+                if (it == data.parameters.end()) return 1;
+                int n = std::stoi(it->second);
+                if (n < 1) {
+                    throw std::logic_error("Invalid " + key + " value");
+                }
+                return static_cast<std::size_t>(n);
+            };
+            spec.servers = count("servers");
+            spec.batch = count("batch");
+
+            // Opcjonalny limit kolejki (pełna kolejka blokuje nadawców)
+            auto cap = data.parameters.find("queue-capacity");
+            if (cap != data.parameters.end()) {
+                int n = std::stoi(cap->second);
+                if (n < 0) {
+                    throw std::logic_error("Invalid queue-capacity value");
+                }
+                spec.capacity = static_cast<std::size_t>(n);
+            }
 
-            factory.add_worker(
-                Worker(id, pd,
-                    std::unique_ptr<IPackageQueue>(
-                        new PackageQueue(qt)))
-            );
+            read_routing_seed(spec, data);
+            read_time_seed(spec, data);
+            draft.workers.push_back(spec);
         }
 
         // ---------------------------------------------------
         // STOREHOUSE
         // ---------------------------------------------------
         else if (data.type == ElementType::STOREHOUSE) {
-            ElementID id = std::stoi(data.parameters.at("id"));
-
-            factory.add_storehouse(Storehouse(id));
+            FactoryDraft::StoreSpec spec;
+            spec.id = std::stoi(data.parameters.at("id"));
+
+            // Opcjonalny tryb magazynu: FULL (domyślnie) lub SUMMARY
+            auto st = data.parameters.find("stockpile");
+            if (st == data.parameters.end() || st->second == "FULL") {
+                spec.stockpile = StockpileType::FULL;
+            } else if (st->second == "SUMMARY") {
+                auto get = [&data](const std::string& key, int def) {
+                    auto it = data.parameters.find(key);
+                    return (it == data.parameters.end()) ? def : std::stoi(it->second);
+                };
+                spec.stockpile = StockpileType::SUMMARY;
+                int sample = get("sample-size", 0);
+                if (sample < 0) {
+                    throw std::logic_error("Invalid sample-size value");
+                }
+                spec.sample_size = static_cast<std::size_t>(sample);
+                spec.histogram_bucket = get("histogram-bucket", 1);
+            } else {
+                throw std::logic_error("Unknown stockpile type");
+            }
+            draft.stores.push_back(spec);
         }
 
         // ---------------------------------------------------
         // LINK
         // ---------------------------------------------------
         else if (data.type == ElementType::LINK) {
-            ElementID src = std::stoi(data.parameters.at("src"));
-            ElementID dest = std::stoi(data.parameters.at("dest"));
+            FactoryDraft::LinkSpec spec;
+            spec.src = std::stoi(data.parameters.at("src"));
+            spec.dest = std::stoi(data.parameters.at("dest"));
+            draft.links.push_back(spec);
+        }
+    }
 
-            // Szukamy nadawcy
-            PackageSender* sender = nullptr;
+    return draft;
+}
 
-            for (auto it = factory.ramp_cbegin(); it != factory.ramp_cend(); ++it) {
-                if (it->get_id() == src) {
-                    sender = const_cast<Ramp*>(&(*it));
-                    break;
-                }
-            }
-            for (auto it = factory.worker_cbegin(); it != factory.worker_cend() && !sender; ++it) {
-                if (it->get_id() == src) {
-                    sender = const_cast<Worker*>(&(*it));
-                    break;
-                }
-            }
+// =======================================================
+// Budowanie fabryki ze szkicu
+// =======================================================
 
-            if (!sender) {
-                throw std::logic_error("Sender not found");
-            }
+Factory IO::build_factory(const FactoryDraft& draft) {
+    Factory factory;
 
-            // Szukamy odbiorcy
-            IPackageReceiver* receiver = nullptr;
+    for (const auto& spec : draft.ramps) {
+        Ramp ramp = spec.traced
+            ? Ramp(spec.id, TraceReader(spec.trace), spec.priority, spec.deadline)
+            : Ramp(spec.id, make_duration_stream(spec.di, spec, false), spec.priority, spec.deadline);
+        apply_routing_seed(ramp, spec);
+        factory.add_ramp(std::move(ramp));
+    }
 
-            for (auto it = factory.worker_cbegin(); it != factory.worker_cend(); ++it) {
-                if (it->get_id() == dest) {
-                    receiver = const_cast<Worker*>(&(*it));
-                    break;
-                }
+    for (const auto& spec : draft.workers) {
+        Worker worker(spec.id, make_duration_stream(spec.pt, spec, true),
+            std::unique_ptr<IPackageQueue>(
+                new PackageQueue(spec.qt)),
+            spec.servers, spec.batch, spec.capacity);
+        apply_routing_seed(worker, spec);
+        factory.add_worker(std::move(worker));
+    }
+
+    for (const auto& spec : draft.stores) {
+        if (spec.stockpile == StockpileType::FULL) {
+            factory.add_storehouse(Storehouse(spec.id));
+        } else {
+            factory.add_storehouse(
+                Storehouse(spec.id,
+                    std::unique_ptr<IPackageStockpile>(
+                        new PackageSummary(spec.sample_size, spec.histogram_bucket)))
+            );
+        }
+    }
+
+    for (const auto& link : draft.links) {
+        // Szukamy nadawcy
+        PackageSender* sender = nullptr;
+
+        for (auto it = factory.ramp_begin(); it != factory.ramp_end(); ++it) {
+            if (it->get_id() == link.src) {
+                sender = &(*it);
+                break;
             }
-            for (auto it = factory.storehouse_cbegin(); it != factory.storehouse_cend() && !receiver; ++it) {
-                if (it->get_id() == dest) {
-                    receiver = const_cast<Storehouse*>(&(*it));
-                    break;
-                }
+        }
+        for (auto it = factory.worker_begin(); it != factory.worker_end() && !sender; ++it) {
+            if (it->get_id() == link.src) {
+                sender = &(*it);
+                break;
             }
+        }
+
+        if (!sender) {
+            throw std::logic_error("Sender not found");
+        }
 
-            if (!receiver) {
-                throw std::logic_error("Receiver not found");
+        // Szukamy odbiorcy
+        IPackageReceiver* receiver = nullptr;
+
+        for (auto it = factory.worker_begin(); it != factory.worker_end(); ++it) {
+            if (it->get_id() == link.dest) {
+                receiver = &(*it);
+                break;
+            }
+        }
+        for (auto it = factory.storehouse_begin(); it != factory.storehouse_end() && !receiver; ++it) {
+            if (it->get_id() == link.dest) {
+                receiver = &(*it);
+                break;
             }
+        }
 
-            sender->receiver_preferences.add_receiver(receiver);
+        if (!receiver) {
+            throw std::logic_error("Receiver not found");
         }
+
+        sender->receiver_preferences.add_receiver(receiver);
     }
 
     return factory;
@@ -176,23 +477,45 @@ void IO::save_factory_structure(const Factory& factory, std::ostream& os) {
 
     // RAMP
     for (auto it = factory.ramp_cbegin(); it != factory.ramp_cend(); ++it) {
-        os << "RAMP id=" << it->get_id()
-           << " delivery-interval=" << it->get_delivery_interval()
-           << "\n";
+        os << "RAMP id=" << it->get_id();
+        if (it->get_trace()) {
+            write_trace_source(*it->get_trace(), os);
+        } else {
+            write_duration(it->get_delivery_stream(), "delivery-interval", os);
+        }
+        if (it->get_priority() != 0) os << " priority=" << it->get_priority();
+        if (it->get_deadline() > 0) os << " deadline=" << it->get_deadline();
+        write_routing_seed(*it, os);
+        if (!it->get_trace()) {
+            write_time_seed(it->get_delivery_stream(), os);
+        }
+        os << "\n";
     }
 
     // WORKER
     for (auto it = factory.worker_cbegin(); it != factory.worker_cend(); ++it) {
-        os << "WORKER id=" << it->get_id()
-           << " processing-time=" << it->get_processing_duration()
-           << " queue-type="
-           << (it->get_queue()->getQueueType() == PackageQueueType::FIFO ? "FIFO" : "LIFO")
-           << "\n";
+        os << "WORKER id=" << it->get_id();
+        write_duration(it->get_processing_stream(), "processing-time", os);
+        os << " queue-type=" << queue_type_name(it->get_queue()->getQueueType());
+        if (it->get_servers() > 1) os << " servers=" << it->get_servers();
+        if (it->get_batch_size() > 1) os << " batch=" << it->get_batch_size();
+        if (it->get_queue_capacity() > 0) os << " queue-capacity=" << it->get_queue_capacity();
+        write_routing_seed(*it, os);
+        write_time_seed(it->get_processing_stream(), os);
+        os << "\n";
     }
 
     // STOREHOUSE
     for (auto it = factory.storehouse_cbegin(); it != factory.storehouse_cend(); ++it) {
-        os << "STOREHOUSE id=" << it->get_id() << "\n";
+        os << "STOREHOUSE id=" << it->get_id();
+
+        auto summary = dynamic_cast<const PackageSummary*>(it->get_stockpile());
+        if (summary) {
+            os << " stockpile=SUMMARY"
+               << " sample-size=" << summary->get_sample_size()
+               << " histogram-bucket=" << summary->get_initial_bucket_width();
+        }
+        os << "\n";
     }
 
     // LINK
@@ -3,6 +3,8 @@
 #include <ostream>
 #include <string>
 #include <map>
+#include <cstdint>
+#include <vector>
 
 #include "Factory/factory.hpp"
 
@@ -13,6 +15,51 @@ struct ParsedLineData {
     ElementType type;
     std::map<std::string, std::string> parameters;
 };
+
+// Sparsowana, jeszcze niezbudowana struktura fabryki
+// (warianty do przeglądu parametrów bez ponownego parsowania tekstu)
+struct FactoryDraft {
+    struct RampSpec {
+        ElementID id;
+        DurationDistribution di;      // liczba tur albo rozkład (exp:, uniform:, ...)
+        int priority = 0;             // priority=P (kolejki PRIORITY)
+        TimeOffset deadline = 0;      // deadline=D -> termin t + D (kolejki EDF)
+        bool seeded = false;          // routing-seed podany
+        std::uint64_t routing_seed = 0;
+        bool time_seeded = false;     // time-seed podany (strumień czasów)
+        std::uint64_t time_seed = 0;
+        bool traced = false;          // trace=PLIK zamiast delivery-interval
+        TraceSource trace;            // trace-scale=S, trace-origin=T
+    };
+    struct WorkerSpec {
+        ElementID id;
+        DurationDistribution pt;
+        PackageQueueType qt;
+        std::size_t servers = 1;      // servers=k (paczki w obróbce naraz)
+        std::size_t batch = 1;        // batch=B (paczki w jednej obróbce)
+        std::size_t capacity = 0;     // queue-capacity=N (0 -> bez limitu)
+        bool seeded = false;
+        std::uint64_t routing_seed = 0;
+        bool time_seeded = false;
+        std::uint64_t time_seed = 0;
+    };
+    struct StoreSpec {
+        ElementID id;
+        StockpileType stockpile = StockpileType::FULL;
+        std::size_t sample_size = 0;
+        TimeOffset histogram_bucket = 1;
+    };
+    struct LinkSpec {
+        ElementID src;
+        ElementID dest;
+    };
+
+    std::vector<RampSpec> ramps;
+    std::vector<WorkerSpec> workers;
+    std::vector<StoreSpec> stores;
+    std::vector<LinkSpec> links;
+};
+
 namespace IO {
 
     // Parsuje pojedynczą linię tekstu
@@ -21,32 +68,12 @@ namespace IO {
     // Wczytuje strukturę fabryki
     Factory load_factory_structure(std::istream& is);
 
+    // Wczytuje strukturę jako szkic (bez budowania węzłów)
+    FactoryDraft load_factory_draft(std::istream& is);
+
+    // Buduje fabrykę ze szkicu
+    Factory build_factory(const FactoryDraft& draft);
+
     // Zapisuje strukturę fabryki
     void save_factory_structure(const Factory& factory, std::ostream& os);
 }
-
-// struct LinkSpec {
-//     NodeType src_type; int src_id;
-//     NodeType dest_type; int dest_id;
-// };
-
-// struct FactoryDraft {
-//     struct RampSpec { int id; int di; };
-//     struct WorkerSpec { int id; int pt; PackageQueueType qt; };
-//     struct StoreSpec { int id; };
-
-//     std::vector<RampSpec> ramps;
-//     std::vector<WorkerSpec> workers;
-//     std::vector<StoreSpec> stores;
-//     std::vector<LinkSpec> links;
-// };
-
-// struct ParsingError : std::runtime_error {
-//     using std::runtime_error::runtime_error;
-// };
-
-// ParsedLineData parse_line(const std::string& line);
-// FactoryDraft load_factory_structure(std::istream& is);
-// void save_factory_structure(const FactoryDraft& d, std::ostream& os);
-
-// std::pair<NodeType,int> parse_node_ref(const std::string& s);
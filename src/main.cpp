@@ -1,10 +1,22 @@
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include "io/Parser.hpp"
 #include "Simulation/Simulation.hpp"
 #include "Reports/Report.hpp"
+#include "Simulation/Arena.hpp"
+#include "Simulation/SteadyState.hpp"
+#include "Simulation/Periodic.hpp"
+#include "Simulation/DispatchCore.hpp"
+#include "Simulation/Sweep.hpp"
+#include "Simulation/Paired.hpp"
+#include "Simulation/Partition.hpp"
+#include "Simulation/TimeWarp.hpp"
+#include "Analysis/Queueing.hpp"
+#include "Analysis/Bottleneck.hpp"
 
-int main() {
+int main(int argc, char* argv[]) {
     std::cout << "START\n";
 
     std::ifstream file("factory.txt");
@@ -13,8 +25,165 @@ int main() {
         return 1;
     }
 
+    // Cała pamięć przebiegu (kolejki, kolekcje, preferencje, rejestr ID) w arenie,
+    // także w trybach wielowątkowych (pool areny jest synchronizowany).
+    // Zakres areny jest zadeklarowany przed fabrykami, więc fabryki giną pierwsze.
+    SimulationArena arena;
+    ArenaScope arena_scope(arena);
+
+    // Tryb benchmarku: netsim --bench-dispatch [liczba tur]
+    if (argc > 1 && std::string(argv[1]) == "--bench-dispatch") {
+        std::stringstream topology;
+        topology << file.rdbuf();
+        TimeOffset d = (argc > 2) ? std::stoi(argv[2]) : 100000;
+
+        DispatchBenchmark b = benchmark_dispatch(topology.str(), d);
+        std::cout << "virtual dispatch : " << b.virtual_ms << " ms\n"
+                  << "handle dispatch  : " << b.handles_ms << " ms\n";
+        return 0;
+    }
+
+    // Oszacowanie analityczne bez symulacji: netsim --analyze
+    if (argc > 1 && std::string(argv[1]) == "--analyze") {
+        Factory factory = IO::load_factory_structure(file);
+        Reports::print_queueing_estimate(analyze_queueing(factory), std::cout);
+        return 0;
+    }
+
+    // Przegląd parametrów: netsim --sweep <liczba tur> [--lhs N] <oś>...
+    // oś: <parametr>@<id>=<v1>,<v2>,...  (processing-time, delivery-interval, queue-type)
+    if (argc > 2 && std::string(argv[1]) == "--sweep") {
+        SweepOptions options;
+        options.turns = std::stoi(argv[2]);
+
+        std::vector<SweepAxis> axes;
+        for (int i = 3; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--lhs" && i + 1 < argc) {
+                options.sampling = SweepSampling::LATIN_HYPERCUBE;
+                options.samples = static_cast<std::size_t>(std::stoul(argv[++i]));
+            } else {
+                axes.push_back(parse_sweep_axis(arg));
+            }
+        }
+
+        FactoryDraft base = IO::load_factory_draft(file);
+        Reports::print_sweep_summary(axes, run_sweep(base, axes, options), std::cout);
+        return 0;
+    }
+
+    // Równoległa praca robotników: netsim --parallel <wątki> [liczba tur]
+    if (argc > 2 && std::string(argv[1]) == "--parallel") {
+        ParallelOptions options;
+        options.threads = static_cast<unsigned>(std::stoul(argv[2]));
+        TimeOffset d = (argc > 3) ? std::stoi(argv[3]) : 1000;
+
+        Factory factory = IO::load_factory_structure(file);
+        std::vector<StealStats> stats = simulate_parallel(factory, d, [](Factory&, Time) {}, options);
+        Reports::print_simulation_state(factory, d, std::cout);
+        Reports::print_scheduler_stats(stats, std::cout);
+        return 0;
+    }
+
+    // Symulacja optymistyczna: netsim --optimistic <części> [liczba tur]
+    if (argc > 2 && std::string(argv[1]) == "--optimistic") {
+        OptimisticOptions options;
+        options.parts = static_cast<std::size_t>(std::stoul(argv[2]));
+        TimeOffset d = (argc > 3) ? std::stoi(argv[3]) : 1000;
+
+        Factory factory = IO::load_factory_structure(file);
+        std::vector<RollbackStats> stats = simulate_optimistic(factory, d, [](Factory&, Time) {}, options);
+        Reports::print_simulation_state(factory, d, std::cout);
+        Reports::print_rollback_stats(stats, std::cout);
+        return 0;
+    }
+
+    // Benchmark przypięcia NUMA: netsim --bench-numa <wątki> [liczba tur]
+    if (argc > 2 && std::string(argv[1]) == "--bench-numa") {
+        std::stringstream topology;
+        topology << file.rdbuf();
+        unsigned threads = static_cast<unsigned>(std::stoul(argv[2]));
+        TimeOffset d = (argc > 3) ? std::stoi(argv[3]) : 1000;
+
+        NumaBenchmark b = benchmark_numa(topology.str(), d, threads);
+        std::cout << "numa nodes       : " << b.nodes << (b.nodes > 1 ? "\n" : " (pinning disabled)\n")
+                  << "unpinned         : " << b.unpinned_ms << " ms\n"
+                  << "pinned           : " << b.pinned_ms << " ms\n"
+                  << "speedup          : " << b.unpinned_ms / b.pinned_ms << "x\n";
+        return 0;
+    }
+
+    // Porównanie scenariuszy: netsim --compare <plik B> <liczba tur> [replikacje]
+    // (factory.txt -> scenariusz A, wspólne strumienie losowe nadawców)
+    if (argc > 3 && std::string(argv[1]) == "--compare") {
+        std::ifstream other(argv[2]);
+        if (!other) {
+            std::cout << "Nie mozna otworzyc " << argv[2] << "\n";
+            return 1;
+        }
+
+        PairedOptions options;
+        options.turns = std::stoi(argv[3]);
+        if (argc > 4) options.replications = static_cast<std::size_t>(std::stoul(argv[4]));
+
+        FactoryDraft a = IO::load_factory_draft(file);
+        FactoryDraft b = IO::load_factory_draft(other);
+        Reports::print_paired_comparison(compare_scenarios(a, b, options), std::cout);
+        return 0;
+    }
+
     Factory factory = IO::load_factory_structure(file);
 
+    // Wąskie gardła po przebiegu: netsim --bottlenecks [liczba tur] [--csv]
+    if (argc > 1 && std::string(argv[1]) == "--bottlenecks") {
+        TimeOffset d = (argc > 2) ? std::stoi(argv[2]) : 1000;
+        simulate(factory, d, [](Factory&, Time) {});
+
+        BottleneckReport report = analyze_bottlenecks(factory, d);
+        if (argc > 3 && std::string(argv[3]) == "--csv") {
+            Reports::write_bottleneck_csv(report, std::cout);
+        } else {
+            Reports::print_bottleneck_report(report, std::cout);
+        }
+        return 0;
+    }
+
+    // Stan ustalony: netsim --steady [tur na partię] [tolerancja względna]
+    if (argc > 1 && std::string(argv[1]) == "--steady") {
+        SteadyStateOptions options;
+        if (argc > 2) options.batch_size = std::stoi(argv[2]);
+        if (argc > 3) options.relative_tolerance = std::stod(argv[3]);
+
+        SteadyStateResult result = simulate_until_steady(factory, options, [](Factory&, Time) {});
+        Reports::print_steady_state(result, std::cout);
+        return 0;
+    }
+
+    // Przeskok powtarzających się okresów: netsim --periodic [liczba tur]
+    // (stan końcowy jak po d turach zwykłej symulacji)
+    if (argc > 1 && std::string(argv[1]) == "--periodic") {
+        TimeOffset d = (argc > 2) ? std::stoi(argv[2]) : 1000;
+
+        PeriodicRunInfo info = simulate_periodic(factory, d, [](Factory&, Time) {});
+        Reports::print_simulation_state(factory, d, std::cout);
+        Reports::print_periodic_run(info, std::cout);
+        return 0;
+    }
+
+    // Symulacja w kilku procesach: netsim --partitioned <procesy> [liczba tur]
+    // (stan końcowy identyczny z przebiegiem jednoprocesowym)
+    if (argc > 2 && std::string(argv[1]) == "--partitioned") {
+        PartitionedOptions options;
+        options.processes = static_cast<std::size_t>(std::stoul(argv[2]));
+        TimeOffset d = (argc > 3) ? std::stoi(argv[3]) : 1000;
+
+        Reports::print_partition(factory, partition_factory(factory, options.processes), std::cout);
+        simulate_partitioned(factory, d, [](Factory& f, Time t) {
+            Reports::print_simulation_state(f, t, std::cout);
+        }, options);
+        return 0;
+    }
+
     std::cout << "\n--- STRUKTURA FABRYKI ---\n";
     Reports::print_factory_structure(factory, std::cout);
 
@@ -0,0 +1,180 @@
+// EngineEquivalenceTest -> każdy silnik symulacji daje ten sam stan co simulate()
+// {
+// Losowe topologie z różnymi cechami węzłów (czasy losowe, stanowiska
+// i partie, kolejki z limitem, PRIORITY / EDF, magazyny SUMMARY);
+// silnik dostaje tylko topologie, które obsługuje:
+// - SOA, HANDLES, CHAINS, event-driven, parallel -> wszystkie
+// - partitioned -> bez kolejek z limitem
+// - optimistic  -> bez kolejek z limitem, stałe odstępy dostaw
+// - periodic    -> liczniki (po przeskoku histogram i próbka magazynu
+//                  są przybliżone), pełny stan gdy bez przeskoku
+// Część topologii także w zakresie ArenaScope (wątki silników alokują
+// w arenie).
+// }
+
+#include "TestUtil.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Simulation/Arena.hpp"
+#include "Simulation/Periodic.hpp"
+#include "Simulation/Partition.hpp"
+#include "Simulation/Simulation.hpp"
+#include "Simulation/TimeWarp.hpp"
+
+static const auto no_report = [](Factory&, Time) {};
+
+struct Engine {
+    const char* name;
+    std::function<bool(const TopologyOptions&)> accepts;
+    std::function<void(Factory&, TimeOffset)> run;
+};
+
+static bool any_topology(const TopologyOptions&) { return true; }
+
+static std::vector<Engine> engines() {
+    return {
+        {"SOA", any_topology,
+         [](Factory& f, TimeOffset d) { simulate(f, d, no_report, ExecutionLayout::SOA); }},
+        {"HANDLES", any_topology,
+         [](Factory& f, TimeOffset d) { simulate(f, d, no_report, ExecutionLayout::HANDLES); }},
+        {"CHAINS", any_topology,
+         [](Factory& f, TimeOffset d) { simulate(f, d, no_report, ExecutionLayout::CHAINS); }},
+        {"event-driven", any_topology,
+         [](Factory& f, TimeOffset d) { simulate_event_driven(f, d, no_report); }},
+        {"parallel", any_topology,
+         [](Factory& f, TimeOffset d) {
+             ParallelOptions options;
+             options.threads = 3;
+             simulate_parallel(f, d, no_report, options);
+         }},
+        {"partitioned",
+         [](const TopologyOptions& o) { return !o.bounded_queues; },
+         [](Factory& f, TimeOffset d) {
+             PartitionedOptions options;
+             options.processes = 3;
+             simulate_partitioned(f, d, no_report, options);
+         }},
+        {"optimistic",
+         [](const TopologyOptions& o) { return !o.bounded_queues && !o.random_deliveries; },
+         [](Factory& f, TimeOffset d) {
+             OptimisticOptions options;
+             options.parts = 3;
+             options.state_interval = 4;
+             options.gvt_interval = 8;
+             simulate_optimistic(f, d, no_report, options);
+         }},
+    };
+}
+
+// Liczniki węzłów i rejestru ID (bez histogramów i próbek magazynów)
+static std::string counters(const Factory& f) {
+    std::ostringstream os;
+    for (auto it = f.ramp_cbegin(); it != f.ramp_cend(); ++it) {
+        os << "R" << it->get_id() << " " << it->get_blocked_turns() << " " << it->get_lost_deliveries() << "\n";
+    }
+    for (auto it = f.worker_cbegin(); it != f.worker_cend(); ++it) {
+        const WorkerStats& s = it->get_stats();
+        os << "W" << it->get_id() << " " << s.received << " " << s.rejected << " " << s.processed
+           << " " << s.busy_turns << " " << s.arrival_time_sum << " " << s.departure_time_sum
+           << " " << it->get_blocked_turns() << " " << it->get_queue()->size() << "\n";
+    }
+    for (auto it = f.storehouse_cbegin(); it != f.storehouse_cend(); ++it) {
+        const DeadlineStats& ds = it->get_deadline_stats();
+        os << "S" << it->get_id() << " " << it->get_stockpile()->size() << " " << ds.due << " " << ds.late
+           << " " << ds.tardiness_sum << " " << ds.max_tardiness << "\n";
+    }
+    os << "next-id " << Package::next_id() << "\n";
+    return os.str();
+}
+
+static TopologyOptions options_for(std::uint64_t seed) {
+    TopologyOptions o;
+    o.stochastic = (seed % 2 == 0);
+    o.multi_server = (seed % 3 == 0);
+    o.bounded_queues = (seed % 4 == 1);
+    o.deadlines = (seed % 5 == 0);
+    o.summary = (seed % 6 == 0);
+    o.random_deliveries = (seed % 7 == 3);
+    return o;
+}
+
+static void report_failure(const char* engine, std::uint64_t seed, const std::string& topology) {
+    std::cerr << "  engine=" << engine << " seed=" << seed << "\n" << topology;
+}
+
+static void check_engines(const std::vector<Engine>& all, std::uint64_t seed) {
+    const TopologyOptions o = options_for(seed);
+    const std::string topology = random_topology(seed, o);
+    const TimeOffset d = 100 + static_cast<TimeOffset>(seed % 4) * 50;
+
+    Factory reference = load_topology(topology);
+    simulate(reference, d, no_report);
+    const std::string expected = factory_state(reference, d);
+
+    for (const Engine& engine : all) {
+        if (!engine.accepts(o)) continue;
+        Factory f = load_topology(topology);
+        engine.run(f, d);
+        bool same = factory_state(f, d) == expected;
+        CHECK(same);
+        if (!same) report_failure(engine.name, seed, topology);
+    }
+}
+
+static void test_engines() {
+    const std::vector<Engine> all = engines();
+    for (std::uint64_t seed = 1; seed <= 60; ++seed) {
+        check_engines(all, seed);
+    }
+}
+
+// Arena zadeklarowana przed fabrykami -> fabryki giną przed końcem zakresu
+static void test_engines_in_arena() {
+    const std::vector<Engine> all = engines();
+    for (std::uint64_t seed = 1; seed <= 20; ++seed) {
+        SimulationArena arena;
+        ArenaScope scope(arena);
+        check_engines(all, seed);
+    }
+}
+
+// Topologie z cyklem stanu (stały routing i czasy, magazyny SUMMARY) i bez
+static void test_periodic() {
+    std::size_t extrapolated = 0;
+
+    for (std::uint64_t seed = 1; seed <= 80; ++seed) {
+        TopologyOptions o = options_for(seed);
+        o.seeded_routing = (seed % 5 == 4);
+        o.stochastic = o.stochastic && o.seeded_routing;
+        o.summary = true;
+        const std::string topology = random_topology(seed, o);
+        const TimeOffset d = 2000;
+
+        Factory reference = load_topology(topology);
+        simulate(reference, d, no_report);
+        const std::string expected = counters(reference);
+        const std::string expected_state = factory_state(reference, d);
+
+        Factory f = load_topology(topology);
+        PeriodicRunInfo info = simulate_periodic(f, d, no_report);
+        bool same = counters(f) == expected &&
+            (info.extrapolated || factory_state(f, d) == expected_state);
+        CHECK(same);
+        if (!same) report_failure("periodic", seed, topology);
+        if (info.extrapolated) ++extrapolated;
+    }
+
+    // przeskok musi być faktycznie sprawdzany
+    CHECK(extrapolated >= 10);
+}
+
+int main() {
+    test_engines();
+    test_engines_in_arena();
+    test_periodic();
+    return test_result();
+}
@@ -0,0 +1,80 @@
+// FactoryConsistencyTest -> spójność sieci (Factory::is_consistent)
+// {
+// - robotnik osiągany z drugiej rampy (wynik dzielony między rampami)
+// - cykl bez wyjścia do magazynu, rampa bez drogi do magazynu
+// - drabina robotników: liczba ścieżek rośnie wykładniczo, węzłów liniowo
+// }
+
+#include "TestUtil.hpp"
+
+#include <sstream>
+#include <string>
+
+// Obie rampy wysyłają do robotnika 100; druga rampa dochodzi do niego,
+// gdy został już odwiedzony z pierwszej
+static void test_worker_reached_from_second_ramp() {
+    Factory f = load_topology(
+        "RAMP id=1 delivery-interval=1\n"
+        "RAMP id=2 delivery-interval=1\n"
+        "WORKER id=100 processing-time=1 queue-type=FIFO\n"
+        "WORKER id=101 processing-time=1 queue-type=FIFO\n"
+        "STOREHOUSE id=200\n"
+        "LINK src=1 dest=100\n"
+        "LINK src=2 dest=101\n"
+        "LINK src=101 dest=100\n"
+        "LINK src=100 dest=200\n");
+    CHECK(f.is_consistent());
+}
+
+static void test_cycle_without_storehouse() {
+    Factory f = load_topology(
+        "RAMP id=1 delivery-interval=1\n"
+        "RAMP id=2 delivery-interval=1\n"
+        "WORKER id=100 processing-time=1 queue-type=FIFO\n"
+        "WORKER id=101 processing-time=1 queue-type=FIFO\n"
+        "STOREHOUSE id=200\n"
+        "LINK src=1 dest=200\n"
+        "LINK src=2 dest=100\n"
+        "LINK src=100 dest=101\n"
+        "LINK src=101 dest=100\n");
+    CHECK(!f.is_consistent());
+}
+
+// Warstwy po dwóch robotników, każdy łączy się z obydwoma z następnej
+// warstwy; ostatnia warstwa tworzy cykl (bez magazynu) albo ma wyjście
+static std::string ladder_topology(int layers, bool exit_to_storehouse) {
+    std::ostringstream os;
+    os << "RAMP id=1 delivery-interval=1\n";
+    os << "STOREHOUSE id=9000\n";
+    for (int i = 0; i < 2 * layers; ++i) {
+        os << "WORKER id=" << (100 + i) << " processing-time=1 queue-type=FIFO\n";
+    }
+    os << "LINK src=1 dest=100\n";
+    os << "LINK src=1 dest=101\n";
+    for (int l = 0; l + 1 < layers; ++l) {
+        for (int a = 0; a < 2; ++a) {
+            for (int b = 0; b < 2; ++b) {
+                os << "LINK src=" << (100 + 2 * l + a) << " dest=" << (100 + 2 * (l + 1) + b) << "\n";
+            }
+        }
+    }
+    const int last = 100 + 2 * (layers - 1);
+    os << "LINK src=" << last << " dest=" << (last + 1) << "\n";
+    os << "LINK src=" << (last + 1) << " dest=" << last << "\n";
+    if (exit_to_storehouse) {
+        os << "LINK src=" << (last + 1) << " dest=9000\n";
+    }
+    return os.str();
+}
+
+static void test_ladder() {
+    CHECK(!load_topology(ladder_topology(64, false)).is_consistent());
+    CHECK(load_topology(ladder_topology(64, true)).is_consistent());
+}
+
+int main() {
+    test_worker_reached_from_second_ramp();
+    test_cycle_without_storehouse();
+    test_ladder();
+    return test_result();
+}
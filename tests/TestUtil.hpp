@@ -0,0 +1,149 @@
+// TestUtil -> wspólne narzędzia testów
+// {
+// CHECK(cond)      -> zgłasza niespełniony warunek (plik, linia), test trwa dalej
+// test_result()    -> kod wyjścia programu testu (0 -> wszystkie warunki spełnione)
+// load_topology()  -> fabryka z tekstu topologii, rejestr ID paczek od nowa
+// random_topology() -> losowa topologia (ziarno) z wybranymi cechami węzłów
+// factory_state()  -> pełny stan fabryki (checkpoint) do porównań silników
+// }
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "io/Checkpoint.hpp"
+#include "io/Parser.hpp"
+
+inline int& test_failures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(cond)                                                          \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            ++test_failures();                                               \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #cond     \
+                      << ") failed\n";                                       \
+        }                                                                    \
+    } while (0)
+
+inline int test_result() {
+    if (test_failures() > 0) {
+        std::cerr << test_failures() << " check(s) failed\n";
+        return 1;
+    }
+    return 0;
+}
+
+// Każdy przebieg od ID 1, jak nowy proces symulatora
+inline Factory load_topology(const std::string& text) {
+    Package::load_registry({}, {});
+    std::istringstream is(text);
+    return IO::load_factory_structure(is);
+}
+
+inline std::string factory_state(const Factory& f, Time t) {
+    std::ostringstream os;
+    IO::save_checkpoint(f, t, os);
+    return os.str();
+}
+
+// =======================================================
+// Losowe topologie
+// =======================================================
+//
+// ID: rampy 1.., robotnicy 100.., magazyny 200..
+// Każdy robotnik ma łącze do magazynu (spójność), łącza między
+// robotnikami mogą tworzyć cykle.
+
+struct TopologyOptions {
+    bool seeded_routing = true;   // routing-seed (inaczej FixedProbability)
+    bool stochastic = false;      // losowe czasy obróbki (exp / uniform)
+    bool random_deliveries = false; // losowe odstępy dostaw na rampach
+    bool multi_server = false;    // servers / batch
+    bool bounded_queues = false;  // queue-capacity
+    bool deadlines = false;       // PRIORITY / EDF, priority / deadline ramp
+    bool summary = false;         // magazyny SUMMARY
+};
+
+inline std::string random_topology(std::uint64_t seed, const TopologyOptions& o = {}) {
+    std::mt19937_64 rng(seed);
+    auto pick = [&rng](int lo, int hi) {
+        return std::uniform_int_distribution<int>(lo, hi)(rng);
+    };
+    auto chance = [&rng](double p) {
+        return std::bernoulli_distribution(p)(rng);
+    };
+
+    const int ramps = pick(1, 4);
+    const int workers = pick(1, 10);
+    const int stores = pick(1, 3);
+
+    std::ostringstream os;
+    for (int i = 0; i < ramps; ++i) {
+        os << "RAMP id=" << (1 + i);
+        if (o.random_deliveries && chance(0.5)) {
+            os << " delivery-interval=uniform:1:" << pick(2, 6);
+        } else {
+            os << " delivery-interval=" << pick(1, 6);
+        }
+        if (o.seeded_routing && chance(0.7)) os << " routing-seed=" << pick(1, 1000);
+        if (o.deadlines) {
+            os << " priority=" << pick(0, 3) << " deadline=" << pick(1, 30);
+        }
+        os << "\n";
+    }
+
+    static const char* fifo_lifo[] = {"FIFO", "LIFO"};
+    static const char* all_queues[] = {"FIFO", "LIFO", "PRIORITY", "EDF"};
+    for (int i = 0; i < workers; ++i) {
+        os << "WORKER id=" << (100 + i) << " processing-time=";
+        if (o.stochastic && chance(0.5)) {
+            if (chance(0.5)) os << "exp:" << pick(1, 4);
+            else os << "uniform:1:" << pick(2, 5);
+        } else {
+            os << pick(1, 4);
+        }
+        os << " queue-type=" << (o.deadlines ? all_queues[pick(0, 3)] : fifo_lifo[pick(0, 1)]);
+        if (o.multi_server && chance(0.4)) os << " servers=" << pick(2, 3);
+        if (o.multi_server && chance(0.3)) os << " batch=" << pick(2, 3);
+        if (o.bounded_queues && chance(0.5)) os << " queue-capacity=" << pick(1, 4);
+        if (o.seeded_routing && chance(0.7)) os << " routing-seed=" << pick(1, 1000);
+        os << "\n";
+    }
+
+    for (int i = 0; i < stores; ++i) {
+        os << "STOREHOUSE id=" << (200 + i);
+        if (o.summary) os << " stockpile=SUMMARY sample-size=" << pick(0, 8) << " histogram-bucket=" << pick(1, 5);
+        os << "\n";
+    }
+
+    auto link = [&os](int src, int dest) {
+        os << "LINK src=" << src << " dest=" << dest << "\n";
+    };
+    for (int i = 0; i < ramps; ++i) {
+        std::vector<int> dests;
+        for (int k = pick(1, 3); k > 0; --k) {
+            int dest = chance(0.8) ? 100 + pick(0, workers - 1) : 200 + pick(0, stores - 1);
+            bool known = false;
+            for (int d : dests) known = known || (d == dest);
+            if (!known) dests.push_back(dest);
+        }
+        for (int d : dests) link(1 + i, d);
+    }
+    for (int i = 0; i < workers; ++i) {
+        link(100 + i, 200 + pick(0, stores - 1));
+        for (int k = pick(0, 2); k > 0; --k) {
+            int dest = 100 + pick(0, workers - 1);
+            if (dest != 100 + i) link(100 + i, dest);
+        }
+    }
+    return os.str();
+}
@@ -0,0 +1,97 @@
+// TimeWarpTest -> simulate_optimistic daje ten sam stan co simulate()
+// {
+// - losowe topologie (cykle między robotnikami, losowy routing i czasy
+//   obróbki) dla różnych liczb części, okresów zapisu stanu, rund GVT
+//   i okien wyprzedzenia
+// - topologia, w której wejście spoza cofnięcia zmieniało stan przed
+//   turą z zachowanymi (niewysłanymi ponownie) paczkami
+// Wątki części dają inny przeplot w każdym przebiegu, więc przypadki
+// są powtarzane.
+// }
+
+#include "TestUtil.hpp"
+
+#include <cstdint>
+#include <string>
+
+#include "Simulation/Simulation.hpp"
+#include "Simulation/TimeWarp.hpp"
+
+static const auto no_report = [](Factory&, Time) {};
+
+static std::string sequential_state(const std::string& topology, TimeOffset d) {
+    Factory f = load_topology(topology);
+    simulate(f, d, no_report);
+    return factory_state(f, d);
+}
+
+static bool optimistic_matches(const std::string& topology, TimeOffset d,
+                               const std::string& expected, const OptimisticOptions& options) {
+    Factory f = load_topology(topology);
+    simulate_optimistic(f, d, no_report, options);
+    return factory_state(f, d) == expected;
+}
+
+static void test_causality_case() {
+    const std::string topology =
+        "RAMP id=1 delivery-interval=4 routing-seed=948\n"
+        "RAMP id=2 delivery-interval=2\n"
+        "WORKER id=100 processing-time=2 queue-type=FIFO routing-seed=620\n"
+        "WORKER id=101 processing-time=1 queue-type=FIFO\n"
+        "STOREHOUSE id=200\n"
+        "LINK src=1 dest=101\n"
+        "LINK src=1 dest=200\n"
+        "LINK src=2 dest=200\n"
+        "LINK src=2 dest=100\n"
+        "LINK src=100 dest=101\n"
+        "LINK src=100 dest=200\n"
+        "LINK src=101 dest=100\n"
+        "LINK src=101 dest=200\n";
+    const TimeOffset d = 75;
+    const std::string expected = sequential_state(topology, d);
+
+    OptimisticOptions options;
+    options.parts = 3;
+    options.state_interval = 3;
+    options.gvt_interval = 5;
+    for (int run = 0; run < 200; ++run) {
+        CHECK(optimistic_matches(topology, d, expected, options));
+    }
+}
+
+static void test_random_topologies() {
+    const std::size_t parts[] = {1, 2, 3, 4, 8};
+    const TimeOffset state_intervals[] = {1, 3, 8};
+    const TimeOffset gvt_intervals[] = {1, 5, 32};
+    const TimeOffset windows[] = {0, 16, 256};
+
+    TopologyOptions topology_options;
+    for (std::uint64_t seed = 1; seed <= 120; ++seed) {
+        topology_options.stochastic = (seed % 2 == 0);
+        const std::string topology = random_topology(seed, topology_options);
+        const TimeOffset d = 40 + static_cast<TimeOffset>(seed % 5) * 40;
+        const std::string expected = sequential_state(topology, d);
+
+        for (std::size_t k = 0; k < 6; ++k) {
+            OptimisticOptions options;
+            options.parts = parts[(seed + k) % 5];
+            options.state_interval = state_intervals[(seed + k) % 3];
+            options.gvt_interval = gvt_intervals[(seed / 3 + k) % 3];
+            options.window = windows[(seed / 9 + k) % 3];
+            bool same = optimistic_matches(topology, d, expected, options);
+            CHECK(same);
+            if (!same) {
+                std::cerr << "  seed=" << seed << " parts=" << options.parts
+                          << " state_interval=" << options.state_interval
+                          << " gvt_interval=" << options.gvt_interval
+                          << " window=" << options.window << "\n" << topology;
+            }
+        }
+    }
+}
+
+int main() {
+    test_causality_case();
+    test_random_topologies();
+    return test_result();
+}
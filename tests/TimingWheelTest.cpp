@@ -0,0 +1,130 @@
+// TimingWheelTest -> terminy dostaw z koła czasowego
+// {
+// - TimingWheel: wyzwolone elementy w każdej turze == reguła (t - 1) % interval == 0
+//   (odstęp 1, odstępy większe od koła, wiele elementów w jednym slocie)
+// - Factory::do_deliveries / next_event_time na kole fabryki (256 slotów)
+// - simulate_event_driven: liczba dostaw po skokach czasu
+// }
+
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "Factory/TimingWheel.hpp"
+#include "Simulation/Simulation.hpp"
+
+// Pierwsza tura >= t z dostawą (reguła sprzed koła czasowego)
+static Time first_delivery_from(Time t, TimeOffset interval) {
+    Time r = (t - 1) % interval;
+    return (r == 0) ? t : t + (interval - r);
+}
+
+static std::vector<TimeOffset> test_intervals() {
+    std::vector<TimeOffset> intervals = {1, 1, 2, 3, 5, 7, 255, 256, 257, 300, 511, 512, 513, 1000};
+    // wiele ramp w jednym slocie koła (ten sam odstęp i wielokrotności 256)
+    for (int k = 0; k < 20; ++k) intervals.push_back(256);
+    for (int k = 0; k < 10; ++k) intervals.push_back(128);
+    for (int k = 1; k <= 4; ++k) intervals.push_back(256 * k);
+    return intervals;
+}
+
+static void test_wheel(std::size_t slots, Time turns) {
+    const std::vector<TimeOffset> intervals = test_intervals();
+    TimingWheel wheel(slots);
+    wheel.reset(0);
+    for (std::size_t i = 0; i < intervals.size(); ++i) {
+        wheel.schedule(1, i);
+    }
+
+    std::vector<TimingWheel::entry_t> due;
+    for (Time t = 1; t <= turns; ++t) {
+        due.clear();
+        wheel.advance(t, due);
+
+        std::vector<std::size_t> fired;
+        for (const auto& e : due) {
+            CHECK(e.first == t);
+            fired.push_back(e.second);
+        }
+        std::sort(fired.begin(), fired.end());
+
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < intervals.size(); ++i) {
+            if ((t - 1) % intervals[i] == 0) expected.push_back(i);
+        }
+        CHECK(fired == expected);
+
+        for (std::size_t i : fired) {
+            wheel.schedule(t + intervals[i], i);
+        }
+
+        Time next = std::numeric_limits<Time>::max();
+        for (TimeOffset interval : intervals) {
+            next = std::min(next, first_delivery_from(t + 1, interval));
+        }
+        CHECK(wheel.next_due() == next);
+    }
+}
+
+static std::string ramps_topology(const std::vector<TimeOffset>& intervals) {
+    std::ostringstream os;
+    for (std::size_t i = 0; i < intervals.size(); ++i) {
+        os << "RAMP id=" << (i + 1) << " delivery-interval=" << intervals[i] << "\n";
+        os << "STOREHOUSE id=" << (1000 + i + 1) << "\n";
+        os << "LINK src=" << (i + 1) << " dest=" << (1000 + i + 1) << "\n";
+    }
+    return os.str();
+}
+
+static std::size_t stored(const Factory& f, std::size_t i) {
+    auto it = f.storehouse_cbegin();
+    std::advance(it, i);
+    return it->get_stockpile()->size();
+}
+
+// Tura po turze: dostawy z koła fabryki == reguła, najbliższe zdarzenie
+// przy pustych buforach == najbliższa dostawa
+static void test_factory_deliveries(Time turns) {
+    const std::vector<TimeOffset> intervals = test_intervals();
+    Factory f = load_topology(ramps_topology(intervals));
+    CHECK(static_cast<std::size_t>(std::distance(f.ramp_cbegin(), f.ramp_cend())) == intervals.size());
+
+    for (Time t = 1; t <= turns; ++t) {
+        f.do_deliveries(t);
+        std::size_t i = 0;
+        for (auto it = f.ramp_cbegin(); it != f.ramp_cend(); ++it, ++i) {
+            CHECK(it->has_package() == ((t - 1) % intervals[i] == 0));
+        }
+        f.do_package_passing();
+        f.do_work(t);
+
+        Time next = std::numeric_limits<Time>::max();
+        for (TimeOffset interval : intervals) {
+            next = std::min(next, first_delivery_from(t + 1, interval));
+        }
+        CHECK(f.next_event_time(t) == next);
+    }
+}
+
+// Skoki czasu simulate_event_driven -> te same dostawy co simulate()
+static void test_event_driven(Time turns) {
+    const std::vector<TimeOffset> intervals = test_intervals();
+    Factory f = load_topology(ramps_topology(intervals));
+    simulate_event_driven(f, turns, [](Factory&, Time) {});
+
+    for (std::size_t i = 0; i < intervals.size(); ++i) {
+        CHECK(stored(f, i) == static_cast<std::size_t>((turns - 1) / intervals[i] + 1));
+    }
+}
+
+int main() {
+    test_wheel(8, 3000);
+    test_wheel(256, 3000);
+    test_factory_deliveries(3000);
+    test_event_driven(2999);
+    test_event_driven(5000);
+    return test_result();
+}